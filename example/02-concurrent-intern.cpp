@@ -0,0 +1,87 @@
+// Measure the throughput of nonstd::concurrent_intern_pool for an increasing number of threads:
+
+#define string_CONFIG_PROVIDE_THREADS  1
+
+#include "nonstd/string.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef nonstd::concurrent_intern_pool pool_type;
+
+std::atomic<std::uint64_t> sink( 0 );   // keep the ids in use
+
+// Intern count strings per thread from a set of texts, starting at a different position per thread;
+// return millions of strings per second:
+
+double run( pool_type & pool, std::vector<std::string> const & texts, unsigned nthreads, std::size_t count )
+{
+    std::vector<std::thread> threads;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for ( unsigned t = 0; t < nthreads; ++t )
+    {
+        threads.push_back( std::thread( [&, t]()
+        {
+            std::size_t i = t * 7919u % texts.size();
+            std::uint64_t sum = 0;
+
+            for ( std::size_t k = 0; k < count; ++k, i = ( i + 104729u ) % texts.size() )
+                sum += pool.intern( texts[i] );
+
+            sink += sum;
+        }));
+    }
+
+    for ( auto & thread : threads )
+        thread.join();
+
+    std::chrono::duration<double> const seconds = std::chrono::steady_clock::now() - start;
+
+    return double( nthreads ) * double( count ) / seconds.count() / 1e6;
+}
+
+int main()
+{
+    std::size_t const unique = 1000000;
+    std::size_t const count  = 2000000;
+
+    std::vector<std::string> texts;
+    for ( std::size_t i = 0; i < unique; ++i )
+        texts.push_back( "host-" + std::to_string( i * 2654435761u % 4294967291u ) + ".example.com" );
+
+    unsigned const max_threads = (std::max)( 1u, std::thread::hardware_concurrency() );
+
+    std::cout << "threads  insert+lookup Mstr/s  lookup Mstr/s\n";
+
+    std::vector<unsigned> thread_counts;
+    for ( unsigned n = 1; n < max_threads; n *= 2 )
+        thread_counts.push_back( n );
+    thread_counts.push_back( max_threads );
+
+    for ( unsigned nthreads : thread_counts )
+    {
+        pool_type pool;
+
+        double const mixed  = run( pool, texts, nthreads, count );  // inserts as long as strings are new
+        double const lookup = run( pool, texts, nthreads, count );  // all strings present: no locks
+
+        std::cout << std::setw( 7 ) << nthreads << std::fixed << std::setprecision( 1 )
+            << std::setw( 23 ) << mixed << std::setw( 15 ) << lookup << "\n";
+    }
+}
+
+// cl -nologo -EHsc -O2 -I../include 02-concurrent-intern.cpp && 02-concurrent-intern.exe
+// g++ -std=c++11 -O2 -Wall -pthread -I../include -o 02-concurrent-intern.exe 02-concurrent-intern.cpp && ./02-concurrent-intern.exe
+
+// Output on a 1-core Intel Xeon VM, g++ 12 -O2; one row per thread count 1, 2, 4, ... up to
+// std::thread::hardware_concurrency(), so a single row here:
+// threads  insert+lookup Mstr/s  lookup Mstr/s
+//       1                    2.9            5.0
@@ -60,6 +60,12 @@
 # define string_CONFIG_PROVIDE_REGEX  0
 #endif
 
+// Provide std::thread-based parallel variants: default off, as it may require linking a thread library.
+
+#if !defined( string_CONFIG_PROVIDE_THREADS )
+# define string_CONFIG_PROVIDE_THREADS  0
+#endif
+
 // Control presence of exception handling (try and auto discover):
 
 #ifndef string_CONFIG_NO_EXCEPTIONS
@@ -174,12 +180,24 @@
 // Presence of C++20 language features:
 
 #define string_HAVE_CHAR8_T                 string_CPP20_000
+#define string_HAVE_RANGES                  string_CPP20_000
+#define string_HAVE_CLASS_NTTP              string_CPP20_000
 
 // Presence of C++ library features:
 
 #define string_HAVE_REGEX                  (string_CPP11_000 && !string_BETWEEN(string_COMPILER_GNUC_VERSION, 1, 490))
 #define string_HAVE_TYPE_TRAITS             string_CPP11_110
 
+#if string_CPP17_OR_GREATER && defined(__has_include)
+# if __has_include(<charconv>)
+#  define string_HAVE_CHARCONV  1
+# endif
+#endif
+
+#ifndef string_HAVE_CHARCONV
+# define string_HAVE_CHARCONV  0
+#endif
+
 // Usage of C++ language features:
 
 #if string_HAVE_CONSTEXPR_11
@@ -227,13 +245,25 @@
 // Additional includes:
 
 #include <cassert>
+#include <cerrno>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 #include <algorithm>    // std::transform()
+#include <array>
+#include <initializer_list>
 #include <iterator>
 #include <locale>
 #include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #if string_HAVE_STRING_VIEW
@@ -242,10 +272,33 @@
 // # pragma message("string.hpp: Using internal nonstd::std17::basic_string_view<CharT>.")
 #endif
 
+#if string_HAVE_RANGES
+# include <ranges>
+#endif
+
+#if string_HAVE_CHARCONV
+# include <charconv>
+#endif
+
+// std::from_chars() for floating point, which is independent of the locale:
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+# define string_HAVE_FROM_CHARS_FLOATING_POINT  1
+#else
+# define string_HAVE_FROM_CHARS_FLOATING_POINT  0
+#endif
+
 #if string_CONFIG_PROVIDE_REGEX && string_HAVE_REGEX
 # include <regex>
 #endif
 
+#if string_CONFIG_PROVIDE_THREADS
+# include <atomic>
+# include <exception>
+# include <mutex>
+# include <thread>
+#endif
+
 namespace nonstd {
 
 //
@@ -755,6 +808,128 @@ string_nodiscard inline string_constexpr char32_t const * default_strip_set( cha
 
 #undef MK_DETAIL_TO_STRING_SV
 
+// Bit manipulation on 64-bit words, e.g. bitmasks of 64 classified characters:
+
+string_nodiscard inline int ctz64( std::uint64_t x ) string_noexcept    // x != 0
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll( x );
+#else
+    int n = 0;
+    for ( ; ( x & 1u ) == 0; x >>= 1 )
+        ++n;
+    return n;
+#endif
+}
+
+string_nodiscard inline int log2_64( std::uint64_t x ) string_noexcept    // x != 0, rounded down
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll( x );
+#else
+    int n = 0;
+    while ( x >>= 1 )
+        ++n;
+    return n;
+#endif
+}
+
+string_nodiscard inline int popcount64( std::uint64_t x ) string_noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll( x );
+#else
+    x = x - ( ( x >> 1 ) & 0x5555555555555555u );
+    x = ( x & 0x3333333333333333u ) + ( ( x >> 2 ) & 0x3333333333333333u );
+    x = ( x + ( x >> 4 ) ) & 0x0f0f0f0f0f0f0f0fu;
+    return static_cast<int>( ( x * 0x0101010101010101u ) >> 56 );
+#endif
+}
+
+// Eight characters as little-endian word; compiles to a single load where possible:
+
+string_nodiscard inline std::uint64_t load_le64( char const * p ) string_noexcept
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_MSC_VER)
+    std::uint64_t result;
+    std::memcpy( &result, p, sizeof result );
+    return result;
+#else
+    std::uint64_t result = 0;
+    for ( int i = 7; i >= 0; --i )
+        result = ( result << 8 ) | static_cast<unsigned char>( p[i] );
+    return result;
+#endif
+}
+
+string_nodiscard inline string_constexpr std::uint64_t broadcast64( char chr ) string_noexcept
+{
+    return 0x0101010101010101u * static_cast<unsigned char>( chr );
+}
+
+// High bit set in exactly the zero bytes of x (no false positives):
+
+string_nodiscard inline string_constexpr std::uint64_t zero_bytes64( std::uint64_t x ) string_noexcept
+{
+    return ~( ( ( x & 0x7f7f7f7f7f7f7f7fu ) + 0x7f7f7f7f7f7f7f7fu ) | x | 0x7f7f7f7f7f7f7f7fu );
+}
+
+// Gather the high bits of the eight bytes into an 8-bit mask, bit i for byte i:
+
+string_nodiscard inline string_constexpr std::uint64_t movemask64( std::uint64_t x ) string_noexcept
+{
+    return ( ( x >> 7 ) * 0x0102040810204080u ) >> 56;
+}
+
+// Bit i set if an odd number of bits 0..i of x is set, e.g. inside-quote mask from quote positions:
+
+string_nodiscard inline string_constexpr14 std::uint64_t prefix_xor64( std::uint64_t x ) string_noexcept
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Bitmask of the positions of chr in p[0..n), n <= 64; for char eight characters at once (SWAR):
+
+template< typename CharT >
+string_nodiscard std::uint64_t match_mask_each( CharT const * p, std::size_t n, CharT chr )
+{
+    std::uint64_t result = 0;
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        if ( p[i] == chr )
+            result |= std::uint64_t( 1 ) << i;
+    }
+    return result;
+}
+
+template< typename CharT >
+string_nodiscard std::uint64_t match_mask( CharT const * p, std::size_t n, CharT chr )
+{
+    return match_mask_each( p, n, chr );
+}
+
+template<>
+string_nodiscard inline std::uint64_t match_mask( char const * p, std::size_t n, char chr )
+{
+    if ( n != 64 )
+        return match_mask_each( p, n, chr );
+
+    std::uint64_t const chars = broadcast64( chr );
+    std::uint64_t result = 0;
+
+    for ( std::size_t i = 0; i != 64; i += 8 )
+    {
+        result |= movemask64( zero_bytes64( load_le64( p + i ) ^ chars ) ) << i;
+    }
+    return result;
+}
+
 }  // namespace detail
 }  // namespace string
 
@@ -793,6 +968,15 @@ using namespace string;
         return text.empty();                                        \
     }
 
+// count_lines()
+
+#define string_MK_COUNT_LINES(T)                                    \
+    string_nodiscard inline std::size_t                             \
+    count_lines( std17::basic_string_view<T> text, bool cr = false )\
+    {                                                               \
+        return detail::count_lines( text, cr );                     \
+    }
+
 //
 // Searching:
 //
@@ -809,6 +993,39 @@ find_first(
     return text.find( seek, pos );
 }
 
+// Position of first occurrence of given non-empty string at or after pos, or npos;
+// skip to candidates via Traits::find() (memchr() for char), verify last and remaining characters:
+
+template< typename CharT >
+string_nodiscard std::size_t
+find_substring(
+    std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> what, std::size_t pos = 0 ) string_noexcept
+{
+    typedef typename std17::basic_string_view<CharT>::traits_type Traits;
+
+    std::size_t const n = what.size();
+
+    if ( n == 0 || pos > text.size() || n > text.size() - pos )
+        return npos;
+
+    CharT const * const seek  = what.data();
+    CharT const * const first = text.data();
+    CharT const * const last  = first + ( text.size() - n + 1 );  // past last candidate
+
+    for ( CharT const * p = first + pos; p != last; ++p )
+    {
+        p = Traits::find( p, to_size_t( last - p ), seek[0] );
+
+        if ( p == string_nullptr )
+            return npos;
+
+        if ( Traits::eq( p[n - 1], seek[n - 1] ) && Traits::compare( p + 1, seek + 1, n - 1 ) == 0 )
+            return to_size_t( p - first );
+    }
+    return npos;
+}
+
 } // namespace detail
 } // namespace string
 
@@ -1551,6 +1768,71 @@ replace_all(
 // split():
 
 namespace string {
+
+// Sentinel of the lazy ranges, equal to an iterator that is exhausted:
+
+struct lazy_sentinel {};
+
+namespace detail {
+
+template< typename CharT >
+class split_options_generator;
+
+} // namespace detail
+
+// Options of split() applied in the same pass: skip empty elements, strip characters in trim from each element,
+// at most max_count elements with the last one holding the remainder, yield delimiter runs as elements too;
+// set by name, e.g. split_options().skip_empty().trim( " " ).max_count( 3 ):
+
+template< typename CharT >
+class basic_split_options
+{
+public:
+    typedef std17::basic_string_view<CharT> view_type;
+
+    basic_split_options()
+        : skip_empty_( false )
+        , trim_()
+        , max_count_( (std::numeric_limits<std::size_t>::max)() )
+        , keep_delimiters_( false )
+    {}
+
+    basic_split_options & skip_empty( bool skip = true ) string_noexcept
+    {
+        skip_empty_ = skip;
+        return *this;
+    }
+
+    basic_split_options & trim( view_type set ) string_noexcept
+    {
+        trim_ = set;
+        return *this;
+    }
+
+    basic_split_options & max_count( std::size_t count ) string_noexcept
+    {
+        max_count_ = count;
+        return *this;
+    }
+
+    basic_split_options & keep_delimiters( bool keep = true ) string_noexcept
+    {
+        keep_delimiters_ = keep;
+        return *this;
+    }
+
+private:
+    template< typename C >
+    friend class detail::split_options_generator;
+
+    bool        skip_empty_;
+    view_type   trim_;
+    std::size_t max_count_;
+    bool        keep_delimiters_;
+};
+
+typedef basic_split_options<char> split_options;
+
 namespace detail {
 
 template< typename CharT >
@@ -1591,137 +1873,5066 @@ split_right(
         return { text.substr( 0, pos - n + 1 ), text.substr( pos + 1 ) };
 }
 
+// split at first occurrence of non-empty string delim, {text, text} if absent:
+
 template< typename CharT >
-string_nodiscard std::vector< std17::basic_string_view<CharT> >
-split( std17::basic_string_view<CharT> text
-    , std17::basic_string_view<CharT> set
-    , std::size_t Nsplit )
+string_nodiscard inline auto
+split_left_on(
+    std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> delim )
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>
 {
-    std::vector< std17::basic_string_view<CharT> > result;
-
-    std17::basic_string_view<CharT> lhs = text;
-    std17::basic_string_view<CharT> rhs;
+        auto const pos = find_substring( text, delim );
 
-    for( std::size_t cnt = 1; ; ++cnt )
-    {
-        if ( cnt >= Nsplit )
-        {
-            result.push_back( lhs );   // push tail:
-            break;
-        }
+        if ( pos == npos )
+            return { text, text };
 
-        std::tie(lhs, rhs) = split_left( lhs, set /*, Nset*/ );
+        return { text.substr( 0, pos ), text.substr( pos + delim.size() ) };
+}
 
-        result.push_back( lhs );
+// split at last occurrence of non-empty string delim, {text, text} if absent:
 
-        if ( lhs.cend() == text.cend() )
-            break;
+template< typename CharT >
+string_nodiscard inline auto
+split_right_on(
+    std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> delim )
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>
+{
+        auto const pos = delim.empty() ? npos : text.rfind( delim );
 
-        lhs = rhs;
-    }
+        if ( pos == npos )
+            return { text, text };
 
-    return result;
+        return { text.substr( 0, pos ), text.substr( pos + delim.size() ) };
 }
 
-} // namespace detail
-} // namespace string
+// View with characters in set removed from left and right:
 
-// split() -> vector
+template< typename CharT >
+string_nodiscard std17::basic_string_view<CharT>
+strip_view( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set )
+{
+    std::size_t const first = text.find_first_not_of( set );
 
-#define string_MK_SPLIT(CharT)                                                                      \
-    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
-    split(                                                                                          \
-        std17::basic_string_view<CharT> text                                                        \
-        , std17::basic_string_view<CharT> set                                                       \
-        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
-    {                                                                                               \
-        return detail::split(text, set, Nsplit );                                                   \
-    }
+    if ( first == npos )
+        return text.substr( text.size() );
 
-#if string_CONFIG_PROVIDE_CHAR_T
+    return text.substr( first, text.find_last_not_of( set ) - first + 1 );
+}
 
-// split_left() -> tuple
+// Delimiter of split_generator: any character of set, consecutive ones taken together:
 
-#define string_MK_SPLIT_LEFT( CharT )                                                               \
-string_nodiscard inline auto                                                                        \
-split_left(                                                                                         \
-    std17::basic_string_view<CharT> text                                                            \
-    , std17::basic_string_view<CharT> set                                                           \
-    , std::size_t count = std::numeric_limits<std::size_t>::max() )                                 \
-    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
-{                                                                                                   \
-    return detail::split_left( text, set, count );                                                  \
-}
+template< typename CharT >
+struct set_delimiter
+{
+    std17::basic_string_view<CharT> set;
 
-// split_right() -> tuple
+    set_delimiter( std17::basic_string_view<CharT> set_ = std17::basic_string_view<CharT>() )
+        : set( set_ ) {}
 
-#define string_MK_SPLIT_RIGHT( CharT )                                                              \
-string_nodiscard inline auto                                                                        \
-split_right(                                                                                        \
-    std17::basic_string_view<CharT> text                                                            \
-    , std17::basic_string_view<CharT> set                                                           \
-    , std::size_t count = std::numeric_limits<std::size_t>::max() )                                 \
-    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
-{                                                                                                   \
-    return detail::split_right( text, set, count );                                                 \
-}
+    string_nodiscard std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>
+    split( std17::basic_string_view<CharT> text ) const
+    {
+        return split_left( text, set );
+    }
+};
 
-#endif // string_CONFIG_PROVIDE_CHAR_T
+// Delimiter of split_generator: string, each occurrence separating two elements:
 
-//
-// Comparision:
-//
+template< typename CharT >
+struct string_delimiter
+{
+    std17::basic_string_view<CharT> delim;
 
-// defined in namespace nonstd
+    string_delimiter( std17::basic_string_view<CharT> delim_ = std17::basic_string_view<CharT>() )
+        : delim( delim_ ) {}
 
-#define string_MK_COMPARE( CharT )                  \
-    string_nodiscard inline string_constexpr14 int  \
-    compare( std17::basic_string_view<CharT> lhs, std17::basic_string_view<CharT> rhs ) string_noexcept \
-    {                                               \
-        return lhs.compare( rhs );                  \
+    string_nodiscard std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>
+    split( std17::basic_string_view<CharT> text ) const
+    {
+        return split_left_on( text, delim );
     }
+};
 
-// defined in namespace nonstd::string::std17
+// Generator of the elements of split(), one per call; yields false when exhausted:
 
-#define string_MK_COMPARE_EQ( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator==( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
-    {                                               \
-        return compare( lhs, rhs ) == 0;            \
-    }
+template< typename CharT, typename Delimiter = set_delimiter<CharT> >
+class split_generator
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+
+    split_generator()
+        : end_( string_nullptr )
+        , delim_()
+        , rest_()
+        , nsplit_( 0 )
+        , count_( 0 )
+        , last_( true )
+    {}
 
-#define string_MK_COMPARE_NE( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator!=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
-    {                                               \
-        return compare( lhs, rhs ) != 0;            \
-    }
+    split_generator( value_type text, Delimiter const & delim, std::size_t nsplit )
+        : end_( text.data() + text.size() )
+        , delim_( delim )
+        , rest_( text )
+        , nsplit_( nsplit )
+        , count_( 0 )
+        , last_( false )
+    {}
 
-#define string_MK_COMPARE_LT( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator<( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )   \
-    {                                               \
-        return compare( lhs, rhs ) < 0;             \
-    }
+    bool operator()( value_type & token )
+    {
+        if ( last_ )
+            return false;
 
-#define string_MK_COMPARE_LE( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator<=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
-    {                                               \
-        return compare( lhs, rhs ) <= 0;            \
-    }
+        if ( ++count_ >= nsplit_ )
+        {
+            token = rest_;      // yield tail
+            last_ = true;
+            return true;
+        }
 
-#define string_MK_COMPARE_GE( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator>=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
-    {                                               \
-        return compare( lhs, rhs ) >= 0;            \
+        std::tie( token, rest_ ) = delim_.split( rest_ );
+
+        last_ = token.data() + token.size() == end_;
+        return true;
     }
 
-#define string_MK_COMPARE_GT( CharT )               \
-    string_nodiscard inline string_constexpr14 bool \
-    operator>( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )   \
-    {                                               \
+private:
+    CharT const * end_;
+    Delimiter     delim_;
+    value_type    rest_;
+    std::size_t   nsplit_;
+    std::size_t   count_;
+    bool          last_;
+};
+
+// Compile-time character set, for char a 256-bit lookup table, otherwise a chain of comparisons:
+
+string_nodiscard inline string_constexpr std::uint64_t set_word( unsigned ) string_noexcept
+{
+    return 0;
+}
+
+template< typename... Chars >
+string_nodiscard inline string_constexpr std::uint64_t set_word( unsigned k, unsigned char chr, Chars... rest ) string_noexcept
+{
+    return ( chr >> 6u == k ? std::uint64_t( 1 ) << ( chr & 63u ) : 0u ) | set_word( k, rest... );
+}
+
+template< typename CharT >
+string_nodiscard inline string_constexpr bool in_set( CharT ) string_noexcept
+{
+    return false;
+}
+
+template< typename CharT, typename... Chars >
+string_nodiscard inline string_constexpr bool in_set( CharT chr, CharT first, Chars... rest ) string_noexcept
+{
+    return chr == first || in_set( chr, rest... );
+}
+
+template< typename CharT, CharT... Set >
+struct static_set
+{
+    string_nodiscard static string_constexpr bool contains( CharT chr ) string_noexcept
+    {
+        return in_set( chr, Set... );
+    }
+};
+
+template< char... Set >
+struct static_set<char, Set...>
+{
+    string_nodiscard static bool contains( char chr ) string_noexcept
+    {
+        static std::uint64_t const words[4] =
+        {
+            set_word( 0, static_cast<unsigned char>( Set )... ), set_word( 1, static_cast<unsigned char>( Set )... ),
+            set_word( 2, static_cast<unsigned char>( Set )... ), set_word( 3, static_cast<unsigned char>( Set )... ),
+        };
+
+        unsigned const u = static_cast<unsigned char>( chr );
+
+        return ( ( words[ u >> 6u ] >> ( u & 63u ) ) & 1u ) != 0;
+    }
+};
+
+// Searching for characters in, or not in, a compile-time set:
+
+template< typename Set, typename CharT >
+string_nodiscard std::size_t find_first_in( std17::basic_string_view<CharT> text, bool in, std::size_t pos = 0 )
+{
+    for ( ; pos < text.size(); ++pos )
+    {
+        if ( Set::contains( text.data()[pos] ) == in )
+            return pos;
+    }
+    return npos;
+}
+
+template< typename Set, typename CharT >
+string_nodiscard std::size_t find_last_in( std17::basic_string_view<CharT> text, bool in )
+{
+    for ( std::size_t pos = text.size(); pos-- != 0; )
+    {
+        if ( Set::contains( text.data()[pos] ) == in )
+            return pos;
+    }
+    return npos;
+}
+
+// Delimiter of split_generator: any character of compile-time set, consecutive ones taken together:
+
+template< typename CharT, typename Set >
+struct static_set_delimiter
+{
+    string_nodiscard std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>
+    split( std17::basic_string_view<CharT> text ) const
+    {
+        std::size_t const pos = find_first_in<Set>( text, true );
+
+        if ( pos == npos )
+            return std::make_tuple( text, text );
+
+        std::size_t const next = find_first_in<Set>( text, false, pos );
+
+        return std::make_tuple( text.substr( 0, pos ), text.substr( next != npos ? next : text.size() ) );
+    }
+};
+
+// Generator of the elements of split() with options applied:
+
+template< typename CharT >
+class split_options_generator
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+
+    split_options_generator()
+        : end_( string_nullptr )
+        , set_()
+        , options_()
+        , rest_()
+        , delimiters_()
+        , count_( 0 )
+        , last_( true )
+    {}
+
+    split_options_generator( value_type text, value_type set, basic_split_options<CharT> const & options )
+        : end_( text.data() + text.size() )
+        , set_( set )
+        , options_( options )
+        , rest_( text )
+        , delimiters_()
+        , count_( 0 )
+        , last_( false )
+    {}
+
+    bool operator()( value_type & token )
+    {
+        for (;;)
+        {
+            if ( ! delimiters_.empty() )
+            {
+                token = delimiters_;
+                delimiters_ = value_type();
+                return true;
+            }
+
+            if ( last_ )
+                return false;
+
+            value_type element = rest_;
+
+            if ( count_ + 1 >= options_.max_count_ )
+            {
+                last_ = true;       // yield remainder
+            }
+            else
+            {
+                value_type tail;
+                std::tie( element, tail ) = split_left( rest_, set_ );
+
+                last_ = element.data() + element.size() == end_;
+
+                if ( options_.keep_delimiters_ && ! last_ )
+                    delimiters_ = value_type( element.data() + element.size(), to_size_t( tail.data() - element.data() ) - element.size() );
+
+                rest_ = tail;
+            }
+
+            element = strip_view( element, options_.trim_ );
+
+            if ( options_.skip_empty_ && element.empty() )
+                continue;
+
+            ++count_;
+            token = element;
+            return true;
+        }
+    }
+
+private:
+    CharT const *              end_;
+    value_type                 set_;
+    basic_split_options<CharT> options_;
+    value_type                 rest_;
+    value_type                 delimiters_;     // pending delimiter run
+    std::size_t                count_;
+    bool                       last_;
+};
+
+// Generator of the elements of split() from right to left; with Nsplit, the last one yielded is the remaining head:
+
+template< typename CharT >
+class rsplit_generator
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+
+    rsplit_generator()
+        : set_()
+        , rest_()
+        , nsplit_( 0 )
+        , count_( 0 )
+        , last_( true )
+    {}
+
+    rsplit_generator( value_type text, value_type set, std::size_t nsplit )
+        : set_( set )
+        , rest_( text )
+        , nsplit_( nsplit )
+        , count_( 0 )
+        , last_( false )
+    {}
+
+    bool operator()( value_type & token )
+    {
+        if ( last_ )
+            return false;
+
+        std::size_t const pos = ++count_ >= nsplit_ ? npos : rest_.find_last_of( set_ );
+
+        if ( pos == npos )
+        {
+            token = rest_;      // yield head
+            last_ = true;
+            return true;
+        }
+
+        std::size_t const head = rest_.find_last_not_of( set_, pos );
+
+        token = rest_.substr( pos + 1 );
+        rest_ = rest_.substr( 0, head == npos ? 0 : head + 1 );     // leading delimiter run: empty head follows
+        return true;
+    }
+
+private:
+    value_type  set_;
+    value_type  rest_;
+    std::size_t nsplit_;
+    std::size_t count_;
+    bool        last_;
+};
+
+// Generator of lines, terminated by LF, CR-LF or, if cr, by a lone CR; terminators excluded:
+
+template< typename CharT >
+class line_generator
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+    typedef typename value_type::traits_type Traits;
+
+    line_generator()
+        : rest_()
+        , cr_( false )
+    {}
+
+    line_generator( value_type text, bool cr )
+        : rest_( text )
+        , cr_( cr )
+    {}
+
+    bool operator()( value_type & line )
+    {
+        if ( rest_.empty() )
+            return false;
+
+        CharT const * const first = rest_.data();
+        CharT const * const last  = rest_.data() + rest_.size();
+        CharT const * pos         = cr_ ? find_cr_lf( first, last ) : Traits::find( first, rest_.size(), CharT('\n') );
+
+        if ( pos == string_nullptr || pos == last )
+        {
+            line  = rest_;
+            rest_ = value_type( last, std::size_t( 0 ) );
+            return true;
+        }
+
+        CharT const * next = pos + 1;
+
+        if ( *pos == CharT('\r') )
+        {
+            if ( next != last && *next == CharT('\n') )
+                ++next;
+        }
+        else if ( pos != first && *( pos - 1 ) == CharT('\r') )
+        {
+            --pos;
+        }
+
+        line  = value_type( first, to_size_t( pos - first ) );
+        rest_ = value_type( next, to_size_t( last - next ) );
+        return true;
+    }
+
+private:
+    static CharT const * find_cr_lf( CharT const * first, CharT const * last )
+    {
+        for ( ; first != last && *first != CharT('\n') && *first != CharT('\r'); ++first )
+            ;
+        return first;
+    }
+
+    value_type rest_;
+    bool       cr_;
+};
+
+// Number of chr in text; for char eight characters at once (SWAR):
+
+template< typename CharT >
+string_nodiscard std::size_t count_of( std17::basic_string_view<CharT> text, CharT chr )
+{
+    return to_size_t( std::count( text.data(), text.data() + text.size(), chr ) );
+}
+
+template<>
+string_nodiscard inline std::size_t count_of( std17::basic_string_view<char> text, char chr )
+{
+    std::uint64_t const chars = broadcast64( chr );
+    std::size_t result = 0;
+    std::size_t i = 0;
+
+    while ( i + 8 <= text.size() )
+    {
+        // per-byte counts, at most 255 words before summing the bytes:
+
+        std::uint64_t counts = 0;
+
+        for ( int k = 0; k != 255 && i + 8 <= text.size(); ++k, i += 8 )
+        {
+            counts += zero_bytes64( load_le64( text.data() + i ) ^ chars ) >> 7;
+        }
+
+        counts = ( counts & 0x00ff00ff00ff00ffu ) + ( ( counts >> 8 ) & 0x00ff00ff00ff00ffu );
+        result += to_size_t( ( counts * 0x0001000100010001u ) >> 48 );
+    }
+
+    return result + to_size_t( std::count( text.data() + i, text.data() + text.size(), chr ) );
+}
+
+// Number of LFs and lone CRs in text[i..); for char eight characters at once (SWAR):
+
+template< typename CharT >
+string_nodiscard std::size_t count_line_ends_each( std17::basic_string_view<CharT> text, std::size_t i )
+{
+    std::size_t result = 0;
+
+    for ( ; i != text.size(); ++i )
+    {
+        CharT const chr = text.data()[i];
+
+        if ( chr == CharT('\n') || ( chr == CharT('\r') && ( i + 1 == text.size() || text.data()[i + 1] != CharT('\n') ) ) )
+            ++result;
+    }
+    return result;
+}
+
+template< typename CharT >
+string_nodiscard std::size_t count_line_ends( std17::basic_string_view<CharT> text, std::size_t i = 0 )
+{
+    return count_line_ends_each( text, i );
+}
+
+template<>
+string_nodiscard inline std::size_t count_line_ends( std17::basic_string_view<char> text, std::size_t i )
+{
+    std::uint64_t const lfs = broadcast64( '\n' );
+    std::uint64_t const crs = broadcast64( '\r' );
+    std::size_t result = 0;
+
+    while ( i + 9 <= text.size() )
+    {
+        std::uint64_t counts = 0;
+
+        for ( int k = 0; k != 255 && i + 9 <= text.size(); ++k, i += 8 )
+        {
+            std::uint64_t const word = load_le64( text.data() + i );
+            std::uint64_t const next = load_le64( text.data() + i + 1 );   // character after each character
+
+            counts += ( zero_bytes64( word ^ lfs ) | ( zero_bytes64( word ^ crs ) & ~zero_bytes64( next ^ lfs ) ) ) >> 7;
+        }
+
+        counts = ( counts & 0x00ff00ff00ff00ffu ) + ( ( counts >> 8 ) & 0x00ff00ff00ff00ffu );
+        result += to_size_t( ( counts * 0x0001000100010001u ) >> 48 );
+    }
+
+    return result + count_line_ends_each( text, i );
+}
+
+// Number of elements of lines(text, cr):
+
+template< typename CharT >
+string_nodiscard std::size_t count_lines( std17::basic_string_view<CharT> text, bool cr )
+{
+    if ( text.empty() )
+        return 0;
+
+    CharT const back = text.data()[ text.size() - 1 ];
+
+    if ( cr )
+        return count_line_ends( text ) + ( back == CharT('\n') || back == CharT('\r') ? 0u : 1u );
+
+    return count_of( text, CharT('\n') ) + ( back == CharT('\n') ? 0u : 1u );
+}
+
+// Generator of (key, value) pairs of elements separated by pair_set, split at the first character of kv_set,
+// without empty elements; key and value stripped of characters in strip_set:
+
+template< typename CharT >
+class pair_generator
+{
+public:
+    typedef std17::basic_string_view<CharT> view_type;
+    typedef std::pair<view_type, view_type> value_type;
+
+    pair_generator()
+        : rest_()
+        , pair_set_()
+        , kv_set_()
+        , strip_set_()
+    {}
+
+    pair_generator( view_type text, view_type pair_set, view_type kv_set, view_type strip_set )
+        : rest_( text )
+        , pair_set_( pair_set )
+        , kv_set_( kv_set )
+        , strip_set_( strip_set )
+    {}
+
+    bool operator()( value_type & kv )
+    {
+        while ( ! rest_.empty() )
+        {
+            std::size_t const pos = rest_.find_first_of( pair_set_ );
+
+            view_type const elem = strip_view( rest_.substr( 0, pos ), strip_set_ );
+
+            rest_ = pos == npos ? rest_.substr( rest_.size() ) : rest_.substr( pos + 1 );
+
+            if ( elem.empty() )
+                continue;
+
+            std::size_t const sep = elem.find_first_of( kv_set_ );
+
+            if ( sep == npos )
+            {
+                kv = value_type( elem, elem.substr( elem.size() ) );
+            }
+            else
+            {
+                kv = value_type( strip_view( elem.substr( 0, sep ), strip_set_ ), strip_view( elem.substr( sep + 1 ), strip_set_ ) );
+            }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    view_type rest_;
+    view_type pair_set_;
+    view_type kv_set_;
+    view_type strip_set_;
+};
+
+template< typename Generator, typename OutputIt >
+OutputIt
+generate_into( Generator gen, OutputIt out )
+{
+    for ( typename Generator::value_type value; gen( value ); )
+    {
+        *out++ = value;
+    }
+
+    return out;
+}
+
+template< typename CharT, typename OutputIt >
+OutputIt
+split_into( std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> set
+    , OutputIt out
+    , std::size_t Nsplit )
+{
+    return generate_into( split_generator<CharT>( text, set, Nsplit ), out );
+}
+
+template< typename CharT >
+string_nodiscard std::vector< std17::basic_string_view<CharT> >
+split( std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> set
+    , std::size_t Nsplit )
+{
+    std::vector< std17::basic_string_view<CharT> > result;
+
+    split_into( text, set, std::back_inserter( result ), Nsplit );
+
+    return result;
+}
+
+template< typename CharT >
+string_nodiscard std::vector< std17::basic_string_view<CharT> >
+rsplit( std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> set
+    , std::size_t Nsplit )
+{
+    std::vector< std17::basic_string_view<CharT> > result;
+
+    generate_into( rsplit_generator<CharT>( text, set, Nsplit ), std::back_inserter( result ) );
+    std::reverse( result.begin(), result.end() );
+
+    return result;
+}
+
+template< std::size_t N, typename CharT >
+string_nodiscard std::tuple< std::array< std17::basic_string_view<CharT>, N >, std::size_t >
+split_n( std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> set )
+{
+    static_assert( N > 0, "split_n<N>(): N must be positive" );
+
+    std::array< std17::basic_string_view<CharT>, N > result;
+
+    auto const last = split_into( text, set, result.begin(), N );
+
+    return std::make_tuple( result, to_size_t( last - result.begin() ) );
+}
+
+template< typename CharT >
+string_nodiscard std::vector< std17::basic_string_view<CharT> >
+split_on( std17::basic_string_view<CharT> text
+    , std17::basic_string_view<CharT> delim
+    , std::size_t Nsplit )
+{
+    std::vector< std17::basic_string_view<CharT> > result;
+
+    generate_into( split_generator<CharT, string_delimiter<CharT> >( text, delim, Nsplit ), std::back_inserter( result ) );
+
+    return result;
+}
+
+// Classify blocks of up to 64 characters into a bitmask of the characters in set:
+
+template< typename CharT >
+class set_classifier
+{
+public:
+    typedef typename std17::basic_string_view<CharT>::traits_type Traits;
+
+    explicit set_classifier( std17::basic_string_view<CharT> set )
+        : set_( set ) {}
+
+    string_nodiscard std::uint64_t operator()( CharT const * p, std::size_t n ) const
+    {
+        std::uint64_t result = 0;
+        for ( std::size_t i = 0; i != n; ++i )
+        {
+            if ( Traits::find( set_.data(), set_.size(), p[i] ) != string_nullptr )
+                result |= std::uint64_t( 1 ) << i;
+        }
+        return result;
+    }
+
+private:
+    std17::basic_string_view<CharT> set_;
+};
+
+// For char, compare eight characters at once against up to four delimiters (SWAR),
+// otherwise look up each character in a table:
+
+template<>
+class set_classifier<char>
+{
+public:
+    explicit set_classifier( std17::basic_string_view<char> set )
+        : swar_( !set.empty() && set.size() <= 4 )
+    {
+        std::fill( table_, table_ + 256, static_cast<unsigned char>( 0 ) );
+
+        for ( std::size_t i = 0; i != set.size(); ++i )
+            table_[ static_cast<unsigned char>( set.data()[i] ) ] = 1;
+
+        for ( std::size_t i = 0; i != 4; ++i )
+            chars_[i] = swar_ ? broadcast64( set.data()[ (std::min)( i, set.size() - 1 ) ] ) : 0;   // repeat last
+    }
+
+    string_nodiscard std::uint64_t operator()( char const * p, std::size_t n ) const
+    {
+        std::uint64_t result = 0;
+
+        if ( swar_ && n == 64 )
+        {
+            for ( std::size_t i = 0; i != 64; i += 8 )
+            {
+                std::uint64_t const word = load_le64( p + i );
+
+                result |= movemask64(
+                      zero_bytes64( word ^ chars_[0] ) | zero_bytes64( word ^ chars_[1] )
+                    | zero_bytes64( word ^ chars_[2] ) | zero_bytes64( word ^ chars_[3] ) ) << i;
+            }
+        }
+        else
+        {
+            for ( std::size_t i = 0; i != n; ++i )
+                result |= std::uint64_t( table_[ static_cast<unsigned char>( p[i] ) ] ) << i;
+        }
+        return result;
+    }
+
+private:
+    bool          swar_;
+    std::uint64_t chars_[4];
+    unsigned char table_[256];
+};
+
+// Structural index: call fn(pos) for the position of each character of text in set, in order:
+
+template< typename CharT, typename Fn >
+void for_each_of( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set, Fn fn )
+{
+    set_classifier<CharT> const classify( set );
+
+    for ( std::size_t base = 0; base < text.size(); base += 64 )
+    {
+        for ( std::uint64_t mask = classify( text.data() + base, (std::min)( text.size() - base, std::size_t( 64 ) ) ); mask != 0; mask &= mask - 1 )
+        {
+            fn( base + to_size_t( ctz64( mask ) ) );
+        }
+    }
+}
+
+template< typename CharT >
+string_nodiscard std::vector<std::size_t>
+find_all_of( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set )
+{
+    std::vector<std::size_t> result;
+
+    for_each_of( text, set, [&result]( std::size_t pos ) { result.push_back( pos ); } );
+
+    return result;
+}
+
+// Call fn(begin, end) for the element positions of split(text, set) via the structural index:
+
+template< typename CharT, typename Fn >
+void split_bulk( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set, Fn fn )
+{
+    std::size_t start = 0;
+    std::size_t prev  = npos;
+
+    for_each_of( text, set, [&]( std::size_t pos )
+    {
+        if ( prev == npos || pos != prev + 1 )
+            fn( start, pos );       // delimiter run starts: element complete
+
+        start = pos + 1;
+        prev  = pos;
+    });
+
+    fn( start, text.size() );
+}
+
+template< typename CharT >
+string_nodiscard std::vector< std::pair< std17::basic_string_view<CharT>, std17::basic_string_view<CharT> > >
+split_pairs( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> pair_set, std17::basic_string_view<CharT> kv_set, std17::basic_string_view<CharT> strip_set )
+{
+    std::vector< std::pair< std17::basic_string_view<CharT>, std17::basic_string_view<CharT> > > result;
+
+    generate_into( pair_generator<CharT>( text, pair_set, kv_set, strip_set ), std::back_inserter( result ) );
+
+    return result;
+}
+
+template< typename CharT >
+string_nodiscard std::vector< std17::basic_string_view<CharT> >
+split_bulk( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set )
+{
+    std::vector< std17::basic_string_view<CharT> > result;
+
+    split_bulk( text, set, [&]( std::size_t first, std::size_t last )
+    {
+        result.push_back( text.substr( first, last - first ) );
+    });
+
+    return result;
+}
+
+// Split in chunks, each ending after a delimiter run, that exec(count, task) processes via task(i), maybe concurrently:
+
+template< typename CharT, typename Executor >
+string_nodiscard std::vector< std17::basic_string_view<CharT> >
+split_parallel( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set, std::size_t nchunks, Executor exec )
+{
+    typedef std17::basic_string_view<CharT> view_type;
+
+    if ( nchunks < 2 || text.size() < nchunks )
+        return split_bulk( text, set );
+
+    // chunk boundaries, moved to just after the next delimiter run:
+
+    std::vector<std::size_t> bounds( 1, 0 );
+
+    for ( std::size_t k = 1; k != nchunks; ++k )
+    {
+        std::size_t pos = (std::max)( bounds.back(), text.size() / nchunks * k );
+
+        pos = text.find_first_of( set, pos );
+        pos = pos == view_type::npos ? text.size() : text.find_first_not_of( set, pos );
+        pos = pos == view_type::npos ? text.size() : pos;
+
+        if ( pos == text.size() )
+            break;
+
+        if ( pos != bounds.back() )
+            bounds.push_back( pos );
+    }
+
+    bounds.push_back( text.size() );
+
+    std::size_t const count = bounds.size() - 1;
+    std::vector< std::vector<view_type> > parts( count );
+
+    exec( count, [&]( std::size_t i )
+    {
+        parts[i] = split_bulk( text.substr( bounds[i], bounds[i + 1] - bounds[i] ), set );
+
+        if ( i + 1 != count )
+            parts[i].pop_back();    // chunk ends in a delimiter run: drop its empty last element
+    });
+
+    std::size_t total = 0;
+    for ( std::size_t i = 0; i != count; ++i )
+        total += parts[i].size();
+
+    std::vector<view_type> result;
+    result.reserve( total );
+
+    for ( std::size_t i = 0; i != count; ++i )
+        result.insert( result.end(), parts[i].begin(), parts[i].end() );
+
+    return result;
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// Executor running each task on its own thread, the last one on the calling thread; the started threads are
+// joined also when starting a thread or the calling thread's task throws, and an exception from a task on
+// another thread is rethrown on the calling thread after all are joined:
+
+struct thread_executor
+{
+    struct joiner
+    {
+        std::vector<std::thread> & threads;
+
+        ~joiner()
+        {
+            for ( std::size_t i = 0; i != threads.size(); ++i )
+            {
+                if ( threads[i].joinable() )
+                    threads[i].join();
+            }
+        }
+    };
+
+    template< typename Task >
+    void operator()( std::size_t count, Task task ) const
+    {
+        std::vector<std::thread> threads;
+        threads.reserve( count );
+#if !string_CONFIG_NO_EXCEPTIONS
+        std::vector<std::exception_ptr> errors( count );
+#endif
+        {
+            joiner const join = { threads };
+
+            for ( std::size_t i = 0; i + 1 < count; ++i )
+            {
+#if string_CONFIG_NO_EXCEPTIONS
+                threads.push_back( std::thread( task, i ) );
+#else
+                std::exception_ptr & error = errors[i];
+
+                threads.push_back( std::thread( [task, i, &error]() mutable
+                {
+                    try
+                    {
+                        task( i );
+                    }
+                    catch ( ... )
+                    {
+                        error = std::current_exception();
+                    }
+                } ) );
+#endif
+            }
+
+            if ( count != 0 )
+                task( count - 1 );
+        }
+#if !string_CONFIG_NO_EXCEPTIONS
+        for ( std::size_t i = 0; i != errors.size(); ++i )
+        {
+            if ( errors[i] )
+                std::rethrow_exception( errors[i] );
+        }
+#endif
+    }
+};
+
+// Number of threads for text of given size, at least 64 kB per thread:
+
+inline std::size_t thread_count( std::size_t size )
+{
+    std::size_t const hw = (std::max)( std::size_t( std::thread::hardware_concurrency() ), std::size_t( 1 ) );
+
+    return (std::max)( (std::min)( hw, size / ( std::size_t( 64 ) * 1024 ) ), std::size_t( 1 ) );
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+// Unquoted delimiters and newlines in p[0..n) as bitmask; in_quote carries the quote state from block to block:
+
+template< typename CharT >
+string_nodiscard std::uint64_t csv_structural( CharT const * p, std::size_t n, CharT delimiter, CharT quote, bool & in_quote )
+{
+    std::uint64_t const inside = prefix_xor64( match_mask( p, n, quote ) ) ^ ( in_quote ? ~std::uint64_t( 0 ) : 0u );
+
+    in_quote = ( inside >> 63 ) != 0;
+
+    return ( match_mask( p, n, delimiter ) | match_mask( p, n, CharT('\n') ) ) & ~inside;
+}
+
+// Forward iterator over the elements produced by a generator:
+
+template< typename Generator >
+class generator_iterator
+{
+public:
+    typedef typename Generator::value_type  value_type;
+    typedef value_type const &              reference;
+    typedef value_type const *              pointer;
+    typedef std::ptrdiff_t                  difference_type;
+    typedef std::forward_iterator_tag       iterator_category;
+#if string_HAVE_RANGES
+    typedef std::forward_iterator_tag       iterator_concept;
+#endif
+
+    generator_iterator()
+        : gen_()
+        , value_()
+        , index_( 0 )
+        , done_( true )
+    {}
+
+    explicit generator_iterator( Generator const & gen )
+        : gen_( gen )
+        , value_()
+        , index_( 0 )
+        , done_( ! gen_( value_ ) )
+    {}
+
+    string_nodiscard reference operator*()  const { return  value_; }
+    string_nodiscard pointer   operator->() const { return &value_; }
+
+    generator_iterator & operator++()
+    {
+        done_ = ! gen_( value_ );
+        ++index_;
+        return *this;
+    }
+
+    generator_iterator operator++( int )
+    {
+        generator_iterator result( *this );
+        ++*this;
+        return result;
+    }
+
+    // iterators of the same range compare equal when at the same element, or both exhausted:
+
+    string_nodiscard friend bool operator==( generator_iterator const & a, generator_iterator const & b )
+    {
+        return a.done_ == b.done_ && ( a.done_ || a.index_ == b.index_ );
+    }
+
+    string_nodiscard friend bool operator!=( generator_iterator const & a, generator_iterator const & b )
+    {
+        return !( a == b );
+    }
+
+    string_nodiscard friend bool operator==( generator_iterator const & it, lazy_sentinel ) { return   it.done_; }
+    string_nodiscard friend bool operator==( lazy_sentinel, generator_iterator const & it ) { return   it.done_; }
+    string_nodiscard friend bool operator!=( generator_iterator const & it, lazy_sentinel ) { return ! it.done_; }
+    string_nodiscard friend bool operator!=( lazy_sentinel, generator_iterator const & it ) { return ! it.done_; }
+
+private:
+    Generator   gen_;
+    value_type  value_;
+    std::size_t index_;
+    bool        done_;
+};
+
+// Lazy range over the elements produced by a generator; end() yields a sentinel as of C++17:
+
+template< typename Generator >
+class generator_view
+#if string_HAVE_RANGES
+    : public std::ranges::view_base
+#endif
+{
+public:
+    typedef generator_iterator<Generator> iterator;
+    typedef iterator                      const_iterator;
+#if string_CPP17_OR_GREATER
+    typedef lazy_sentinel                 sentinel;
+#else
+    typedef iterator                      sentinel;
+#endif
+
+    generator_view()
+        : gen_()
+    {}
+
+    explicit generator_view( Generator const & gen )
+        : gen_( gen )
+    {}
+
+    string_nodiscard iterator begin() const { return iterator( gen_ ); }
+    string_nodiscard sentinel end()   const { return sentinel(); }
+
+private:
+    Generator gen_;
+};
+
+} // namespace detail
+
+// Lazy split range:
+
+template< typename CharT >
+using basic_split_view = detail::generator_view< detail::split_generator<CharT> >;
+
+template< typename CharT >
+using basic_split_on_view = detail::generator_view< detail::split_generator<CharT, detail::string_delimiter<CharT> > >;
+
+// Lazy reverse split range:
+
+template< typename CharT >
+using basic_rsplit_view = detail::generator_view< detail::rsplit_generator<CharT> >;
+
+// Lazy split range with options:
+
+template< typename CharT >
+using basic_split_options_view = detail::generator_view< detail::split_options_generator<CharT> >;
+
+// Lazy lines range:
+
+template< typename CharT >
+using basic_lines_view = detail::generator_view< detail::line_generator<CharT> >;
+
+// Lazy key-value pairs range:
+
+template< typename CharT >
+using basic_split_pairs_view = detail::generator_view< detail::pair_generator<CharT> >;
+
+// Compact split result: 32-bit offset and length per element into the original text:
+
+template< typename CharT >
+class basic_token_table
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+    typedef std::size_t                     size_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std17::basic_string_view<CharT>  value_type;
+        typedef value_type                       reference;
+        typedef void                             pointer;
+        typedef std::ptrdiff_t                   difference_type;
+        typedef std::random_access_iterator_tag  iterator_category;
+
+        const_iterator()
+            : table_( string_nullptr ), index_( 0 ) {}
+
+        const_iterator( basic_token_table const * table, std::size_t index )
+            : table_( table ), index_( index ) {}
+
+        string_nodiscard reference operator*()                       const { return (*table_)[ index_ ]; }
+        string_nodiscard reference operator[]( difference_type n )   const { return (*table_)[ to_size_t( to_difference_type( index_ ) + n ) ]; }
+
+        const_iterator & operator++()                    { ++index_; return *this; }
+        const_iterator & operator--()                    { --index_; return *this; }
+        const_iterator   operator++( int )               { const_iterator r( *this ); ++index_; return r; }
+        const_iterator   operator--( int )               { const_iterator r( *this ); --index_; return r; }
+        const_iterator & operator+=( difference_type n ) { index_ = to_size_t( to_difference_type( index_ ) + n ); return *this; }
+        const_iterator & operator-=( difference_type n ) { return *this += -n; }
+
+        string_nodiscard friend const_iterator  operator+( const_iterator it, difference_type n ) { return it += n; }
+        string_nodiscard friend const_iterator  operator+( difference_type n, const_iterator it ) { return it += n; }
+        string_nodiscard friend const_iterator  operator-( const_iterator it, difference_type n ) { return it -= n; }
+        string_nodiscard friend difference_type operator-( const_iterator const & a, const_iterator const & b ) { return to_difference_type( a.index_ ) - to_difference_type( b.index_ ); }
+
+        string_nodiscard friend bool operator==( const_iterator const & a, const_iterator const & b ) { return a.index_ == b.index_; }
+        string_nodiscard friend bool operator!=( const_iterator const & a, const_iterator const & b ) { return a.index_ != b.index_; }
+        string_nodiscard friend bool operator< ( const_iterator const & a, const_iterator const & b ) { return a.index_ <  b.index_; }
+        string_nodiscard friend bool operator<=( const_iterator const & a, const_iterator const & b ) { return a.index_ <= b.index_; }
+        string_nodiscard friend bool operator> ( const_iterator const & a, const_iterator const & b ) { return a.index_ >  b.index_; }
+        string_nodiscard friend bool operator>=( const_iterator const & a, const_iterator const & b ) { return a.index_ >= b.index_; }
+
+    private:
+        static std::ptrdiff_t to_difference_type( std::size_t n ) { return static_cast<std::ptrdiff_t>( n ); }
+        static std::size_t    to_size_t( std::ptrdiff_t n )       { return static_cast<std::size_t>( n ); }
+
+        basic_token_table const * table_;
+        std::size_t               index_;
+    };
+
+    typedef const_iterator iterator;
+
+    basic_token_table()
+        : text_()
+        , tokens_()
+    {}
+
+    // text must be smaller than 4 GiB; it is referenced, not copied:
+
+    basic_token_table( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> set )
+        : text_( text )
+        , tokens_()
+    {
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( static_cast<std::uint64_t>( text.size() ) <= max_text_size() );
+#else
+        if ( static_cast<std::uint64_t>( text.size() ) > max_text_size() )
+        {
+            throw std::out_of_range("split_offsets(): text of 4 GiB or more");
+        }
+#endif
+        detail::split_bulk( text, set, [this]( std::size_t first, std::size_t last )
+        {
+            tokens_.push_back( token( static_cast<std::uint32_t>( first ), static_cast<std::uint32_t>( last - first ) ) );
+        });
+    }
+
+    string_nodiscard value_type operator[]( size_type i ) const
+    {
+        return value_type( text_.data() + tokens_[i].offset, tokens_[i].length );
+    }
+
+    string_nodiscard size_type   offset( size_type i ) const { return tokens_[i].offset; }
+    string_nodiscard size_type   length( size_type i ) const { return tokens_[i].length; }
+
+    string_nodiscard size_type   size()  const string_noexcept { return tokens_.size(); }
+    string_nodiscard bool        empty() const string_noexcept { return tokens_.empty(); }
+    string_nodiscard value_type  text()  const string_noexcept { return text_; }
+
+    string_nodiscard const_iterator begin() const { return const_iterator( this, 0 ); }
+    string_nodiscard const_iterator end()   const { return const_iterator( this, size() ); }
+
+    static string_constexpr std::uint64_t max_text_size() string_noexcept { return 0xffffffffu; }
+
+private:
+    struct token
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+
+        token( std::uint32_t offset_, std::uint32_t length_ )
+            : offset( offset_ ), length( length_ ) {}
+    };
+
+    std17::basic_string_view<CharT> text_;
+    std::vector<token>              tokens_;
+};
+
+// CSV/TSV record: fields as string_view, valid until the next call of basic_csv_reader::next():
+
+template< typename CharT >
+class basic_csv_record
+{
+public:
+    typedef std17::basic_string_view<CharT>                    value_type;
+    typedef std::size_t                                        size_type;
+    typedef typename std::vector<value_type>::const_iterator   const_iterator;
+    typedef const_iterator                                     iterator;
+
+    basic_csv_record()
+        : fields_()
+        , buffer_()
+    {}
+
+    // fields may refer to buffer_:
+
+    basic_csv_record( basic_csv_record const & ) = delete;
+    basic_csv_record & operator=( basic_csv_record const & ) = delete;
+
+    string_nodiscard value_type operator[]( size_type i ) const { return fields_[i]; }
+
+    string_nodiscard size_type size()  const string_noexcept { return fields_.size(); }
+    string_nodiscard bool      empty() const string_noexcept { return fields_.empty(); }
+
+    string_nodiscard const_iterator begin() const { return fields_.begin(); }
+    string_nodiscard const_iterator end()   const { return fields_.end(); }
+
+private:
+    template< typename > friend class basic_csv_reader;
+
+    void clear()
+    {
+        fields_.clear();
+        buffer_.clear();
+    }
+
+    std::vector<value_type>  fields_;
+    std::basic_string<CharT> buffer_;   // unescaped fields
+};
+
+// Incremental RFC 4180 CSV/TSV reader: feed() a chunk and take its records with next() until it returns false,
+// then feed() the next chunk, or finish() after the last one to also obtain a final record without newline.
+// Fields refer to the chunk without copying, except for a record that straddles chunks or contains doubled quotes.
+// Enclosing quotes are removed, "" becomes ", a CR before the LF is dropped and empty lines are skipped.
+
+template< typename CharT >
+class basic_csv_reader
+{
+public:
+    typedef std17::basic_string_view<CharT> string_view_type;
+
+    explicit basic_csv_reader( CharT delimiter = CharT(','), CharT quote = CharT('"') )
+        : delimiter_( delimiter )
+        , quote_( quote )
+        , chunk_()
+        , pos_( 0 )
+        , base_( 0 )
+        , mask_( 0 )
+        , in_quote_( false )
+        , finished_( false )
+        , carry_()
+        , line_()
+        , delims_()
+    {}
+
+    // chunk must remain valid while records from it are in use:
+
+    void feed( string_view_type chunk )
+    {
+        chunk_ = chunk;
+        pos_   = 0;
+        base_  = 0;
+        scan_block();
+    }
+
+    // no more chunks: the remaining input forms the last record:
+
+    void finish()
+    {
+        finished_ = true;
+    }
+
+    // next record, false if more input is needed or input is exhausted:
+
+    bool next( basic_csv_record<CharT> & record )
+    {
+        for (;;)
+        {
+            std::size_t end = 0;
+            bool found = false;
+
+            delims_.clear();
+
+            while ( next_structural( end ) )
+            {
+                if ( chunk_.data()[end] == CharT('\n') )
+                {
+                    found = true;
+                    break;
+                }
+                delims_.push_back( end - pos_ );
+            }
+
+            if ( found && carry_.empty() )
+            {
+                string_view_type const line( chunk_.data() + pos_, end - pos_ );
+                pos_ = end + 1;
+
+                if ( make_record( line, delims_, record ) )
+                    return true;
+
+                continue;
+            }
+
+            if ( ! found )
+            {
+                carry_.append( chunk_.data() + pos_, chunk_.size() - pos_ );
+                end = pos_ = chunk_.size();
+
+                if ( ! finished_ || carry_.empty() )
+                {
+                    record.clear();
+                    return false;
+                }
+            }
+
+            // record straddling chunks, or the last one without newline:
+
+            line_.assign( carry_ ).append( chunk_.data() + pos_, end - pos_ );
+            carry_.clear();
+            pos_ = (std::min)( end + 1, chunk_.size() );
+
+            if ( make_record( string_view_type( line_.data(), line_.size() ), index( line_ ), record ) )
+                return true;
+        }
+    }
+
+private:
+    void scan_block()
+    {
+        mask_ = detail::csv_structural( chunk_.data() + base_, (std::min)( chunk_.size() - base_, std::size_t( 64 ) ), delimiter_, quote_, in_quote_ );
+    }
+
+    // position of next unquoted delimiter or newline in chunk, false at end of chunk:
+
+    bool next_structural( std::size_t & pos )
+    {
+        while ( mask_ == 0 )
+        {
+            if ( base_ + 64 >= chunk_.size() )
+                return false;
+
+            base_ += 64;
+            scan_block();
+        }
+
+        pos = base_ + detail::to_size_t( detail::ctz64( mask_ ) );
+        mask_ &= mask_ - 1;
+        return true;
+    }
+
+    // unquoted delimiter positions in complete line:
+
+    std::vector<std::size_t> const & index( std::basic_string<CharT> const & line )
+    {
+        bool in_quote = false;
+        delims_.clear();
+
+        for ( std::size_t base = 0; base < line.size(); base += 64 )
+        {
+            for ( std::uint64_t mask = detail::csv_structural( line.data() + base, (std::min)( line.size() - base, std::size_t( 64 ) ), delimiter_, quote_, in_quote ); mask != 0; mask &= mask - 1 )
+            {
+                delims_.push_back( base + detail::to_size_t( detail::ctz64( mask ) ) );
+            }
+        }
+        return delims_;
+    }
+
+    // fields of line separated at delims, false for an empty line:
+
+    bool make_record( string_view_type line, std::vector<std::size_t> const & delims, basic_csv_record<CharT> & record ) const
+    {
+        record.clear();
+
+        if ( !line.empty() && line.data()[ line.size() - 1 ] == CharT('\r') )
+            line = line.substr( 0, line.size() - 1 );
+
+        if ( line.empty() )
+            return false;
+
+        if ( record.buffer_.capacity() < line.size() )
+            record.buffer_.reserve( line.size() );   // no reallocation: unescaped fields are shorter
+
+        std::size_t first = 0;
+
+        for ( std::size_t i = 0; i <= delims.size(); ++i )
+        {
+            std::size_t const last = i < delims.size() ? delims[i] : line.size();
+            record.fields_.push_back( unquote( string_view_type( line.data() + first, last - first ), record.buffer_ ) );
+            first = last + 1;
+        }
+        return true;
+    }
+
+    string_view_type unquote( string_view_type field, std::basic_string<CharT> & buffer ) const
+    {
+        if ( field.size() < 2 || field.data()[0] != quote_ || field.data()[ field.size() - 1 ] != quote_ )
+            return field;
+
+        field = string_view_type( field.data() + 1, field.size() - 2 );
+
+        if ( field.find( quote_ ) == string_view_type::npos )
+            return field;
+
+        std::size_t const start = buffer.size();
+
+        for ( std::size_t i = 0; i < field.size(); ++i )
+        {
+            buffer.push_back( field.data()[i] );
+
+            if ( field.data()[i] == quote_ )
+                ++i;
+        }
+        return string_view_type( buffer.data() + start, buffer.size() - start );
+    }
+
+    CharT                    delimiter_;
+    CharT                    quote_;
+    string_view_type         chunk_;
+    std::size_t              pos_;          // start of current record in chunk
+    std::size_t              base_;         // start of current 64-character block
+    std::uint64_t            mask_;         // unvisited unquoted delimiters and newlines of block
+    bool                     in_quote_;     // quote state at end of block
+    bool                     finished_;
+    std::basic_string<CharT> carry_;        // start of record straddling chunks
+    std::basic_string<CharT> line_;         // straddling record completed
+    std::vector<std::size_t> delims_;       // delimiter positions in record
+};
+
+typedef basic_csv_record<char> csv_record;
+typedef basic_csv_reader<char> csv_reader;
+
+// Incremental tokenizer with split() semantics over a stream of chunks: feed() a chunk and take its tokens
+// with next() until it returns false, then feed() the next chunk, or finish() after the last one.
+// Tokens refer to the chunk, except a token that straddles chunks, which is copied; a token is valid
+// until the next call of next().
+
+template< typename CharT >
+class basic_tokenizer
+{
+public:
+    typedef std17::basic_string_view<CharT> string_view_type;
+
+    explicit basic_tokenizer( string_view_type set )
+        : set_( set.begin(), set.end() )
+        , chunk_()
+        , pos_( 0 )
+        , carry_()
+        , token_()
+        , started_( false )
+        , delimited_( false )
+        , finished_( false )
+        , done_( false )
+    {}
+
+    // chunk must remain valid while tokens from it are in use:
+
+    void feed( string_view_type chunk )
+    {
+        chunk_ = chunk;
+        pos_   = 0;
+    }
+
+    // no more chunks: yield the pending token and the empty last element after a trailing delimiter:
+
+    void finish()
+    {
+        finished_ = true;
+    }
+
+    // next token, false if more input is needed or input is exhausted:
+
+    bool next( string_view_type & token )
+    {
+        string_view_type const set( set_.data(), set_.size() );
+
+        if ( pos_ != chunk_.size() )
+        {
+            if ( carry_.empty() )
+            {
+                std::size_t const first = (std::min)( chunk_.find_first_not_of( set, pos_ ), chunk_.size() );
+
+                if ( first != pos_ )
+                {
+                    bool const leading = ! started_;
+
+                    started_   = true;
+                    delimited_ = true;
+                    pos_       = first;
+
+                    if ( leading )
+                    {
+                        token = chunk_.substr( 0, 0 );     // leading delimiter: empty first element
+                        return true;
+                    }
+                }
+            }
+
+            if ( pos_ != chunk_.size() )
+            {
+                std::size_t const last = chunk_.find_first_of( set, pos_ );
+
+                started_   = true;
+                delimited_ = false;
+
+                if ( last != npos )
+                {
+                    token = chunk_.substr( pos_, last - pos_ );
+                    pos_  = last;
+
+                    if ( ! carry_.empty() )
+                        token = take_carry( token );
+
+                    return true;
+                }
+
+                carry_.append( chunk_.data() + pos_, chunk_.size() - pos_ );
+                pos_ = chunk_.size();
+            }
+        }
+
+        if ( ! finished_ || done_ )
+            return false;
+
+        // end of stream:
+
+        done_ = true;
+
+        if ( ! carry_.empty() )
+            token = take_carry( string_view_type() );
+        else if ( delimited_ || ! started_ )
+            token = string_view_type();     // trailing delimiter or empty input: empty last element
+        else
+            return false;
+
+        return true;
+    }
+
+private:
+    string_view_type take_carry( string_view_type tail )
+    {
+        token_.swap( carry_ );
+        token_.append( tail.data(), tail.size() );
+        carry_.clear();
+
+        return string_view_type( token_.data(), token_.size() );
+    }
+
+    std::basic_string<CharT> set_;
+    string_view_type         chunk_;
+    std::size_t              pos_;          // scan position in chunk
+    std::basic_string<CharT> carry_;        // start of token straddling chunks
+    std::basic_string<CharT> token_;        // straddling token completed
+    bool                     started_;      // any character seen
+    bool                     delimited_;    // last character seen is a delimiter
+    bool                     finished_;
+    bool                     done_;
+};
+
+typedef basic_tokenizer<char> tokenizer;
+
+// Shell-style tokens: separated by delimiter runs, with quoted sections and escaped characters taken literally.
+// A token refers to the text, or to the inner text of a token that is a single quoted section; only a token that
+// needs unescaping is copied, into an arena that is allocated on first use. The escape character, none if CharT(),
+// escapes the next character, also within quotes.
+
+template< typename CharT >
+class basic_quoted_tokens
+{
+public:
+    typedef std17::basic_string_view<CharT>                    value_type;
+    typedef std::size_t                                        size_type;
+    typedef typename std::vector<value_type>::const_iterator   const_iterator;
+    typedef const_iterator                                     iterator;
+
+    basic_quoted_tokens()
+        : tokens_()
+        , arena_()
+        , used_( 0 )
+    {}
+
+    basic_quoted_tokens( value_type text, value_type delims, value_type quotes, CharT escape )
+        : tokens_()
+        , arena_()
+        , used_( 0 )
+    {
+        if ( text.find_first_of( quotes ) == npos && ( escape == CharT() || text.find( escape ) == npos ) )
+        {
+            detail::split_bulk( text, delims, [&]( std::size_t first, std::size_t last )
+            {
+                if ( first != last )
+                    tokens_.push_back( text.substr( first, last - first ) );
+            });
+            return;
+        }
+
+        for ( std::size_t pos = text.find_first_not_of( delims ); pos < text.size(); pos = text.find_first_not_of( delims, pos ) )
+        {
+            std::size_t const first = pos;
+            bool plain = true;
+
+            while ( pos < text.size() && delims.find( text.data()[pos] ) == npos )
+            {
+                CharT const chr = text.data()[pos];
+
+                if ( chr == escape && escape != CharT() )
+                {
+                    plain = false;
+                    pos += 2;
+                }
+                else if ( quotes.find( chr ) != npos )
+                {
+                    plain = false;
+                    for ( ++pos; pos < text.size() && text.data()[pos] != chr; ++pos )
+                    {
+                        if ( text.data()[pos] == escape && escape != CharT() )
+                            ++pos;
+                    }
+                    ++pos;
+                }
+                else
+                {
+                    ++pos;
+                }
+            }
+
+            pos = (std::min)( pos, text.size() );
+
+            tokens_.push_back( plain ? text.substr( first, pos - first ) : unquote( text, text.substr( first, pos - first ), quotes, escape ) );
+        }
+    }
+
+    string_nodiscard value_type operator[]( size_type i ) const { return tokens_[i]; }
+
+    string_nodiscard size_type size()  const string_noexcept { return tokens_.size(); }
+    string_nodiscard bool      empty() const string_noexcept { return tokens_.empty(); }
+
+    string_nodiscard const_iterator begin() const { return tokens_.begin(); }
+    string_nodiscard const_iterator end()   const { return tokens_.end(); }
+
+private:
+    value_type unquote( value_type text, value_type token, value_type quotes, CharT escape )
+    {
+        CharT const front = token.data()[0];
+
+        // single quoted section without escapes: inner text
+
+        if ( token.size() >= 2 && quotes.find( front ) != npos && token.data()[ token.size() - 1 ] == front )
+        {
+            value_type const inner = token.substr( 1, token.size() - 2 );
+
+            if ( inner.find( front ) == npos && ( escape == CharT() || inner.find( escape ) == npos ) )
+                return inner;
+        }
+
+        if ( ! arena_ )
+            arena_.reset( new CharT[ text.size() ] );
+
+        CharT * const first = arena_.get() + used_;
+        CharT * out = first;
+        CharT quote = CharT();
+
+        for ( std::size_t i = 0; i < token.size(); ++i )
+        {
+            CharT const chr = token.data()[i];
+
+            if ( chr == escape && escape != CharT() )
+            {
+                if ( ++i < token.size() )
+                    *out++ = token.data()[i];
+            }
+            else if ( quote != CharT() ? chr == quote : quotes.find( chr ) != npos )
+            {
+                quote = quote != CharT() ? CharT() : chr;    // open or close quoted section
+            }
+            else
+            {
+                *out++ = chr;
+            }
+        }
+
+        used_ += detail::to_size_t( out - first );
+        return value_type( first, detail::to_size_t( out - first ) );
+    }
+
+    std::vector<value_type>   tokens_;
+    std::unique_ptr<CharT[]>  arena_;   // unescaped tokens
+    std::size_t               used_;
+};
+
+} // namespace string
+
+// split() -> vector
+
+#define string_MK_SPLIT(CharT)                                                                      \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    split(                                                                                          \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return detail::split(text, set, Nsplit );                                                   \
+    }
+
+// split_into() -> output iterator
+
+#define string_MK_SPLIT_INTO(CharT)                                                                 \
+    template< typename OutputIt >                                                                   \
+    OutputIt                                                                                        \
+    split_into(                                                                                     \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , OutputIt out                                                                              \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return detail::split_into( text, set, out, Nsplit );                                        \
+    }
+
+// split_n<N>() -> tuple of array and count
+
+#define string_MK_SPLIT_N(CharT)                                                                    \
+    template< std::size_t N >                                                                       \
+    string_nodiscard std::tuple< std::array< std17::basic_string_view<CharT>, N >, std::size_t >    \
+    split_n(                                                                                        \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set )                                                     \
+    {                                                                                               \
+        return detail::split_n<N>( text, set );                                                     \
+    }
+
+// Compile-time character set variants of find_first_of() etc., strip_left() etc. and split():
+
+#define string_MK_STATIC_SET_FIND(CharT)                                                            \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::size_t find_first_of( std17::basic_string_view<CharT> text )              \
+    {                                                                                               \
+        return detail::find_first_in< detail::static_set<CharT, Set...> >( text, true );            \
+    }                                                                                               \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::size_t find_last_of( std17::basic_string_view<CharT> text )               \
+    {                                                                                               \
+        return detail::find_last_in< detail::static_set<CharT, Set...> >( text, true );             \
+    }                                                                                               \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::size_t find_first_not_of( std17::basic_string_view<CharT> text )          \
+    {                                                                                               \
+        return detail::find_first_in< detail::static_set<CharT, Set...> >( text, false );           \
+    }                                                                                               \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::size_t find_last_not_of( std17::basic_string_view<CharT> text )           \
+    {                                                                                               \
+        return detail::find_last_in< detail::static_set<CharT, Set...> >( text, false );            \
+    }
+
+#define string_MK_STATIC_SET_STRIP(CharT)                                                           \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::basic_string<CharT> strip_left( std17::basic_string_view<CharT> text )    \
+    {                                                                                               \
+        return std::basic_string<CharT>( text ).erase( 0, find_first_not_of<Set...>( text ) );      \
+    }                                                                                               \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::basic_string<CharT> strip_right( std17::basic_string_view<CharT> text )   \
+    {                                                                                               \
+        return std::basic_string<CharT>( text ).erase( find_last_not_of<Set...>( text ) + 1 );      \
+    }                                                                                               \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::basic_string<CharT> strip( std17::basic_string_view<CharT> text )         \
+    {                                                                                               \
+        return strip_left<Set...>( strip_right<Set...>( text ) );                                   \
+    }
+
+#define string_MK_STATIC_SET_SPLIT(CharT)                                                           \
+    template< CharT... Set >                                                                        \
+    string_nodiscard std::vector< std17::basic_string_view<CharT>>                                  \
+    split(                                                                                          \
+        std17::basic_string_view<CharT> text                                                        \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        typedef detail::static_set_delimiter< CharT, detail::static_set<CharT, Set...> > delimiter; \
+        std::vector< std17::basic_string_view<CharT> > result;                                      \
+        detail::generate_into( detail::split_generator<CharT, delimiter>( text, delimiter(), Nsplit ), std::back_inserter( result ) ); \
+        return result;                                                                              \
+    }
+
+// split() with options -> vector, split_view() with options -> lazy range
+
+#define string_MK_SPLIT_OPTIONS(CharT)                                                              \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    split(                                                                                          \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , basic_split_options<CharT> const & options )                                              \
+    {                                                                                               \
+        std::vector< std17::basic_string_view<CharT> > result;                                      \
+        detail::generate_into( detail::split_options_generator<CharT>( text, set, options ), std::back_inserter( result ) ); \
+        return result;                                                                              \
+    }                                                                                               \
+    string_nodiscard inline basic_split_options_view<CharT>                                         \
+    split_view(                                                                                     \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , basic_split_options<CharT> const & options )                                              \
+    {                                                                                               \
+        return basic_split_options_view<CharT>( detail::split_options_generator<CharT>( text, set, options ) ); \
+    }
+
+// split_quoted() -> tokens
+
+#define string_MK_SPLIT_QUOTED(CharT)                                                               \
+    string_nodiscard inline basic_quoted_tokens<CharT>                                              \
+    split_quoted(                                                                                   \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> delims                                                    \
+        , std17::basic_string_view<CharT> quotes                                                    \
+        , CharT escape = CharT('\\') )                                                              \
+    {                                                                                               \
+        return basic_quoted_tokens<CharT>( text, delims, quotes, escape );                          \
+    }
+
+// rsplit() -> vector
+
+#define string_MK_RSPLIT(CharT)                                                                     \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    rsplit(                                                                                         \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return detail::rsplit( text, set, Nsplit );                                                 \
+    }
+
+// rsplit_view() -> lazy range, right to left
+
+#define string_MK_RSPLIT_VIEW(CharT)                                                                \
+    string_nodiscard inline basic_rsplit_view<CharT>                                                \
+    rsplit_view(                                                                                    \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return basic_rsplit_view<CharT>( detail::rsplit_generator<CharT>( text, set, Nsplit ) );   \
+    }
+
+// split_view() -> lazy range
+
+#define string_MK_SPLIT_VIEW(CharT)                                                                 \
+    string_nodiscard inline basic_split_view<CharT>                                                 \
+    split_view(                                                                                     \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return basic_split_view<CharT>( detail::split_generator<CharT>( text, set, Nsplit ) );     \
+    }
+
+// find_all_of() -> vector of positions
+
+#define string_MK_FIND_ALL_OF(CharT)                                                                \
+    string_nodiscard inline std::vector<std::size_t>                                                \
+    find_all_of(                                                                                    \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set )                                                     \
+    {                                                                                               \
+        return detail::find_all_of( text, set );                                                    \
+    }
+
+// split_bulk() -> vector
+
+#define string_MK_SPLIT_BULK(CharT)                                                                 \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    split_bulk(                                                                                     \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set )                                                     \
+    {                                                                                               \
+        return detail::split_bulk( text, set );                                                     \
+    }
+
+// split_offsets() -> token table
+
+#define string_MK_SPLIT_OFFSETS(CharT)                                                              \
+    string_nodiscard inline basic_token_table<CharT>                                                \
+    split_offsets(                                                                                  \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set )                                                     \
+    {                                                                                               \
+        return basic_token_table<CharT>( text, set );                                               \
+    }
+
+// lines() -> lazy range
+
+#define string_MK_LINES(CharT)                                                                      \
+    string_nodiscard inline basic_lines_view<CharT>                                                 \
+    lines(                                                                                          \
+        std17::basic_string_view<CharT> text                                                        \
+        , bool cr = false )                                                                         \
+    {                                                                                               \
+        return basic_lines_view<CharT>( detail::line_generator<CharT>( text, cr ) );                \
+    }
+
+// split_parallel() -> vector
+
+#if string_CONFIG_PROVIDE_THREADS
+# define string_MK_SPLIT_PARALLEL_THREADS(CharT)                                                    \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    split_parallel(                                                                                 \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set )                                                     \
+    {                                                                                               \
+        return detail::split_parallel( text, set, detail::thread_count( text.size() ), detail::thread_executor() ); \
+    }
+#else
+# define string_MK_SPLIT_PARALLEL_THREADS(CharT)  /*empty*/
+#endif
+
+#define string_MK_SPLIT_PARALLEL(CharT)                                                             \
+    template< typename Executor >                                                                   \
+    string_nodiscard std::vector< std17::basic_string_view<CharT>>                                  \
+    split_parallel(                                                                                 \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> set                                                       \
+        , std::size_t nchunks                                                                       \
+        , Executor exec )                                                                           \
+    {                                                                                               \
+        return detail::split_parallel( text, set, nchunks, exec );                                  \
+    }                                                                                               \
+    string_MK_SPLIT_PARALLEL_THREADS(CharT)
+
+// split_pairs() -> vector of pairs
+
+#define string_MK_SPLIT_PAIRS(CharT)                                                                \
+    string_nodiscard inline std::vector< std::pair< std17::basic_string_view<CharT>, std17::basic_string_view<CharT> > > \
+    split_pairs(                                                                                    \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> pair_set                                                  \
+        , std17::basic_string_view<CharT> kv_set                                                    \
+        , std17::basic_string_view<CharT> strip_set = std17::basic_string_view<CharT>() )           \
+    {                                                                                               \
+        return detail::split_pairs( text, pair_set, kv_set, strip_set );                            \
+    }
+
+// split_pairs_view() -> lazy range of pairs
+
+#define string_MK_SPLIT_PAIRS_VIEW(CharT)                                                           \
+    string_nodiscard inline basic_split_pairs_view<CharT>                                           \
+    split_pairs_view(                                                                               \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> pair_set                                                  \
+        , std17::basic_string_view<CharT> kv_set                                                    \
+        , std17::basic_string_view<CharT> strip_set = std17::basic_string_view<CharT>() )           \
+    {                                                                                               \
+        return basic_split_pairs_view<CharT>( detail::pair_generator<CharT>( text, pair_set, kv_set, strip_set ) ); \
+    }
+
+// split_on() -> vector
+
+#define string_MK_SPLIT_ON(CharT)                                                                   \
+    string_nodiscard inline std::vector< std17::basic_string_view<CharT>>                           \
+    split_on(                                                                                       \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> delim                                                     \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return detail::split_on( text, delim, Nsplit );                                             \
+    }
+
+// split_on_view() -> lazy range
+
+#define string_MK_SPLIT_ON_VIEW(CharT)                                                              \
+    string_nodiscard inline basic_split_on_view<CharT>                                              \
+    split_on_view(                                                                                  \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> delim                                                     \
+        , std::size_t Nsplit = std::numeric_limits<std::size_t>::max() )                            \
+    {                                                                                               \
+        return basic_split_on_view<CharT>(                                                          \
+            detail::split_generator<CharT, detail::string_delimiter<CharT> >( text, delim, Nsplit ) ); \
+    }
+
+// split_left_on() -> tuple
+
+#define string_MK_SPLIT_LEFT_ON( CharT )                                                            \
+string_nodiscard inline auto                                                                        \
+split_left_on(                                                                                      \
+    std17::basic_string_view<CharT> text                                                            \
+    , std17::basic_string_view<CharT> delim )                                                       \
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
+{                                                                                                   \
+    return detail::split_left_on( text, delim );                                                    \
+}
+
+// split_right_on() -> tuple
+
+#define string_MK_SPLIT_RIGHT_ON( CharT )                                                           \
+string_nodiscard inline auto                                                                        \
+split_right_on(                                                                                     \
+    std17::basic_string_view<CharT> text                                                            \
+    , std17::basic_string_view<CharT> delim )                                                       \
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
+{                                                                                                   \
+    return detail::split_right_on( text, delim );                                                   \
+}
+
+#if string_CONFIG_PROVIDE_CHAR_T
+
+// split_left() -> tuple
+
+#define string_MK_SPLIT_LEFT( CharT )                                                               \
+string_nodiscard inline auto                                                                        \
+split_left(                                                                                         \
+    std17::basic_string_view<CharT> text                                                            \
+    , std17::basic_string_view<CharT> set                                                           \
+    , std::size_t count = std::numeric_limits<std::size_t>::max() )                                 \
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
+{                                                                                                   \
+    return detail::split_left( text, set, count );                                                  \
+}
+
+// split_right() -> tuple
+
+#define string_MK_SPLIT_RIGHT( CharT )                                                              \
+string_nodiscard inline auto                                                                        \
+split_right(                                                                                        \
+    std17::basic_string_view<CharT> text                                                            \
+    , std17::basic_string_view<CharT> set                                                           \
+    , std::size_t count = std::numeric_limits<std::size_t>::max() )                                 \
+    -> std::tuple<std17::basic_string_view<CharT>, std17::basic_string_view<CharT>>                 \
+{                                                                                                   \
+    return detail::split_right( text, set, count );                                                 \
+}
+
+#endif // string_CONFIG_PROVIDE_CHAR_T
+
+//
+// Scanning:
+//
+
+namespace string {
+
+// Result of scan(): whether the text matches the pattern, and the position in text past the match, npos if not matched:
+
+struct scan_result
+{
+    bool        matched;
+    std::size_t end;
+
+    string_explicit operator bool() const string_noexcept { return matched; }
+};
+
+namespace detail {
+
+// Pattern of literal text and fields "{}", with "{{" and "}}" for a literal brace. A literal is matched at the
+// current position in text, a field extends to the first occurrence of the literal that follows it, or to the end
+// of text if the pattern ends with the field:
+
+template< typename CharT >
+struct scanner
+{
+    typedef std17::basic_string_view<CharT> view;
+
+    view        text;
+    view        pattern;
+    std::size_t pos;        // in text
+    std::size_t ppos;       // in pattern
+
+    scanner( view text_, view pattern_ )
+        : text( text_ )
+        , pattern( pattern_ )
+        , pos( 0 )
+        , ppos( 0 )
+    {}
+
+    bool is_field( std::size_t p ) const
+    {
+        return p + 1 < pattern.size() && pattern.data()[p] == CharT('{') && pattern.data()[p + 1] == CharT('}');
+    }
+
+    // width in pattern of the literal character at p, 2 for an escaped brace:
+
+    std::size_t width( std::size_t p ) const
+    {
+        CharT const chr = pattern.data()[p];
+        return ( chr == CharT('{') || chr == CharT('}') ) && p + 1 < pattern.size() && pattern.data()[p + 1] == chr ? 2u : 1u;
+    }
+
+    // end in pattern of the literal at p, at the next field or the end of pattern:
+
+    std::size_t literal_end( std::size_t p ) const
+    {
+        while ( p < pattern.size() && ! is_field( p ) )
+            p += width( p );
+        return p;
+    }
+
+    // match pattern literal [p, last) at text position t, set end past it in text:
+
+    bool match_at( std::size_t t, std::size_t p, std::size_t last, std::size_t & end ) const
+    {
+        for ( ; p < last; p += width( p ), ++t )
+        {
+            if ( t == text.size() || text.data()[t] != pattern.data()[p] )
+                return false;
+        }
+        end = t;
+        return true;
+    }
+
+    bool match_literal()
+    {
+        std::size_t const last = literal_end( ppos );
+
+        if ( ! match_at( pos, ppos, last, pos ) )
+            return false;
+
+        ppos = last;
+        return true;
+    }
+
+    // next field and the literal that follows it; adjacent fields do not match:
+
+    bool next_field( view & field )
+    {
+        if ( ! is_field( ppos ) )
+            return false;
+
+        ppos += 2;
+        std::size_t const last = literal_end( ppos );
+
+        if ( last == ppos )
+        {
+            if ( ppos != pattern.size() )
+                return false;
+
+            field = text.substr( pos );
+            pos   = text.size();
+            return true;
+        }
+
+        // seek candidates by the literal's leading characters up to a brace:
+
+        std::size_t n = 0;
+        while ( ppos + n < last && pattern.data()[ppos + n] != CharT('{') && pattern.data()[ppos + n] != CharT('}') )
+            ++n;
+
+        view const seek = pattern.substr( ppos, (std::max)( n, std::size_t( 1 ) ) );
+
+        for ( std::size_t t = find_substring( text, seek, pos ); t != npos; t = find_substring( text, seek, t + 1 ) )
+        {
+            std::size_t end = 0;
+
+            if ( match_at( t, ppos, last, end ) )
+            {
+                field = text.substr( pos, t - pos );
+                pos   = end;
+                ppos  = last;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Convert field to view, integer or floating point number; a number must occupy the entire field:
+
+template< typename CharT >
+bool scan_convert( std17::basic_string_view<CharT> field, std17::basic_string_view<CharT> & value )
+{
+    value = field;
+    return true;
+}
+
+template< typename CharT, typename T >
+typename std::enable_if< std::is_integral<T>::value && ! std::is_same<T, bool>::value, bool >::type
+scan_convert( std17::basic_string_view<CharT> field, T & value )
+{
+    typedef typename std::make_unsigned<T>::type U;
+
+    CharT const * const data = field.data();
+    std::size_t const   size = field.size();
+
+    bool const negative = size > 0 && data[0] == CharT('-');
+    std::size_t i = size > 0 && ( negative || data[0] == CharT('+') ) ? 1u : 0u;
+
+    if ( i == size || ( negative && ! std::is_signed<T>::value ) )
+        return false;
+
+    U const limit = negative ? U( U( (std::numeric_limits<T>::max)() ) + 1u ) : U( (std::numeric_limits<T>::max)() );
+    U result = 0;
+
+    for ( ; i < size; ++i )
+    {
+        if ( data[i] < CharT('0') || data[i] > CharT('9') )
+            return false;
+
+        U const digit = U( data[i] - CharT('0') );
+
+        if ( result > U( ( limit - digit ) / 10u ) )
+            return false;
+
+        result = U( result * 10u + digit );
+    }
+
+    value = negative ? T( -T( result - 1u ) - 1 ) : T( result );
+    return true;
+}
+
+#if string_HAVE_FROM_CHARS_FLOATING_POINT
+
+// Decimal or "inf" or "nan" with optional sign, not hexadecimal, independent of the locale; a value out of range,
+// i.e. overflowing or underflowing to zero, is not accepted:
+
+template< typename T >
+bool parse_floating( char const * first, char const * last, T & value )
+{
+    if ( last - first > 1 && first[0] == '+' && first[1] != '-' )
+        ++first;
+
+    std::from_chars_result const result = std::from_chars( first, last, value );
+
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+#else
+
+inline float       strto( char const * str, char ** end, float       * ) { return std::strtof ( str, end ); }
+inline double      strto( char const * str, char ** end, double      * ) { return std::strtod ( str, end ); }
+inline long double strto( char const * str, char ** end, long double * ) { return std::strtold( str, end ); }
+
+// Same as above via strtod(): hexadecimal is rejected, '.' is replaced by the decimal point of the locale, and
+// overflow or underflow to zero is rejected as ERANGE with an infinite or zero result:
+
+template< typename T >
+bool parse_floating( char * first, char * last, T & value )
+{
+    char const * digits = first + ( first != last && ( *first == '+' || *first == '-' ) ? 1 : 0 );
+
+    if ( last - digits > 1 && digits[0] == '0' && ( digits[1] == 'x' || digits[1] == 'X' ) )
+        return false;
+
+    char const point = *std::localeconv()->decimal_point;
+
+    if ( point != '.' )
+    {
+        if ( std::find( first, last, point ) != last )
+            return false;
+
+        std::replace( first, last, '.', point );
+    }
+
+    int const saved_errno = errno;
+    errno = 0;
+
+    char * end = string_nullptr;
+    T const result = strto( first, &end, static_cast<T *>( string_nullptr ) );
+
+    T const max = (std::numeric_limits<T>::max)();
+    bool const out_of_range = errno == ERANGE && ( result == 0 || result > max || result < -max );
+    errno = saved_errno;
+
+    if ( end != last || out_of_range )
+        return false;
+
+    value = result;
+    return true;
+}
+
+#endif // string_HAVE_FROM_CHARS_FLOATING_POINT
+
+template< typename CharT, typename T >
+typename std::enable_if< std::is_floating_point<T>::value, bool >::type
+scan_convert( std17::basic_string_view<CharT> field, T & value )
+{
+    char buffer[64];
+
+    if ( field.size() == 0 || field.size() >= sizeof buffer )
+        return false;
+
+    for ( std::size_t i = 0; i < field.size(); ++i )
+    {
+        CharT const chr = field.data()[i];
+
+        if ( chr <= CharT(' ') || chr > CharT('~') )
+            return false;
+
+        buffer[i] = static_cast<char>( chr );
+    }
+    buffer[ field.size() ] = '\0';
+
+    return parse_floating( buffer, buffer + field.size(), value );
+}
+
+template< typename CharT >
+bool scan_fields( scanner<CharT> & s )
+{
+    return s.ppos == s.pattern.size();
+}
+
+template< typename CharT, typename T, typename... Rest >
+bool scan_fields( scanner<CharT> & s, T & value, Rest &... rest )
+{
+    std17::basic_string_view<CharT> field;
+
+    return s.next_field( field ) && scan_convert( field, value ) && scan_fields( s, rest... );
+}
+
+template< std::size_t I, typename CharT, typename Tuple >
+typename std::enable_if< I == std::tuple_size<Tuple>::value, bool >::type
+scan_tuple( scanner<CharT> & s, Tuple & )
+{
+    return s.ppos == s.pattern.size();
+}
+
+template< std::size_t I, typename CharT, typename Tuple >
+typename std::enable_if< I < std::tuple_size<Tuple>::value, bool >::type
+scan_tuple( scanner<CharT> & s, Tuple & values )
+{
+    std17::basic_string_view<CharT> field;
+
+    return s.next_field( field ) && scan_convert( field, std::get<I>( values ) ) && scan_tuple<I + 1>( s, values );
+}
+
+template< typename CharT, typename... Args >
+scan_result
+scan( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> pattern, Args &... args )
+{
+    scanner<CharT> s( text, pattern );
+
+    bool const matched = s.match_literal() && scan_fields( s, args... );
+
+    scan_result const result = { matched, matched ? s.pos : npos };
+    return result;
+}
+
+// values are value-initialized, element 0 is the scan_result:
+
+template< typename CharT, typename Tuple >
+Tuple
+scan_values( std17::basic_string_view<CharT> text, std17::basic_string_view<CharT> pattern )
+{
+    Tuple values;
+    scanner<CharT> s( text, pattern );
+
+    bool const matched = s.match_literal() && scan_tuple<1>( s, values );
+
+    scan_result const result = { matched, matched ? s.pos : npos };
+    std::get<0>( values ) = result;
+    return values;
+}
+
+} // namespace detail
+} // namespace string
+
+// scan() -> scan_result, fields into given views and numbers
+
+#define string_MK_SCAN(CharT)                                                                       \
+    template< typename... Args >                                                                    \
+    string_nodiscard scan_result                                                                    \
+    scan(                                                                                           \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> pattern                                                   \
+        , Args &... args )                                                                          \
+    {                                                                                               \
+        return detail::scan( text, pattern, args... );                                              \
+    }
+
+// scan<T...>() -> tuple of scan_result and fields as given types
+
+#define string_MK_SCAN_VALUES(CharT)                                                                \
+    template< typename T, typename... Ts >                                                          \
+    string_nodiscard std::tuple<scan_result, T, Ts...>                                              \
+    scan(                                                                                           \
+        std17::basic_string_view<CharT> text                                                        \
+        , std17::basic_string_view<CharT> pattern )                                                 \
+    {                                                                                               \
+        return detail::scan_values<CharT, std::tuple<scan_result, T, Ts...> >( text, pattern );     \
+    }
+
+//
+// Hashing:
+//
+
+namespace string {
+
+template< typename CharT >
+class basic_hashed_string_view;
+
+namespace detail {
+
+#if defined( __SIZEOF_INT128__ )
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+// Full 64 x 64 -> 128-bit product, low half into a, high half into b:
+
+inline string_constexpr14 void mul128( std::uint64_t & a, std::uint64_t & b ) string_noexcept
+{
+#if defined( __SIZEOF_INT128__ )
+    uint128_t const r = uint128_t( a ) * b;
+    a = static_cast<std::uint64_t>( r );
+    b = static_cast<std::uint64_t>( r >> 64 );
+#else
+    std::uint64_t const ha = a >> 32, la = a & 0xffffffffu;
+    std::uint64_t const hb = b >> 32, lb = b & 0xffffffffu;
+    std::uint64_t const rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t const t  = rl + ( rm0 << 32 );
+    std::uint64_t const lo = t + ( rm1 << 32 );
+
+    a = lo;
+    b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + std::uint64_t( t < rl ) + std::uint64_t( lo < t );
+#endif
+}
+
+string_nodiscard inline string_constexpr14 std::uint64_t hash_mix( std::uint64_t a, std::uint64_t b ) string_noexcept
+{
+    mul128( a, b );
+    return a ^ b;
+}
+
+// Bytes of the code units of a string in little-endian order, independent of the platform's byte order;
+// for char, the shifted bytes of r4() and r8() compile to a single load where possible. Offsets i of r4() and
+// r8() are at a code unit:
+
+template< typename CharT >
+struct hash_bytes
+{
+    typedef typename std::make_unsigned<CharT>::type unit_type;
+
+    CharT const * data;
+
+    // byte k of the code units from q:
+
+    string_nodiscard static string_constexpr14 std::uint64_t byte( CharT const * q, std::size_t k ) string_noexcept
+    {
+        return ( std::uint64_t( static_cast<unit_type>( q[ k / sizeof(CharT) ] ) ) >> ( 8 * ( k % sizeof(CharT) ) ) ) & 0xffu;
+    }
+
+    string_nodiscard string_constexpr14 std::uint64_t r3( std::size_t n ) const string_noexcept
+    {
+        return byte( data, 0 ) << 16 | byte( data, n / 2 ) << 8 | byte( data, n - 1 );
+    }
+
+    string_nodiscard string_constexpr14 std::uint64_t r4( std::size_t i ) const string_noexcept
+    {
+        CharT const * const q = data + i / sizeof(CharT);
+
+        return byte( q, 0 ) | byte( q, 1 ) << 8 | byte( q, 2 ) << 16 | byte( q, 3 ) << 24;
+    }
+
+    string_nodiscard string_constexpr14 std::uint64_t r8( std::size_t i ) const string_noexcept
+    {
+        CharT const * const q = data + i / sizeof(CharT);
+
+        return byte( q, 0 )       | byte( q, 1 ) <<  8 | byte( q, 2 ) << 16 | byte( q, 3 ) << 24
+             | byte( q, 4 ) << 32 | byte( q, 5 ) << 40 | byte( q, 6 ) << 48 | byte( q, 7 ) << 56;
+    }
+};
+
+// 64-bit hash of the bytes of a string after wyhash (final version 4, public domain): wide multiplies that fold
+// 16 bytes per step, in three independent lanes for more than 48 bytes:
+
+template< typename CharT >
+string_nodiscard string_constexpr14 std::uint64_t
+hash( std17::basic_string_view<CharT> text, std::uint64_t seed ) string_noexcept
+{
+    std::uint64_t const s0 = 0x2d358dccaa6c78a5u;
+    std::uint64_t const s1 = 0x8bb84b93962eacc9u;
+    std::uint64_t const s2 = 0x4b33a62ed433d4a3u;
+    std::uint64_t const s3 = 0x4d5a2da51de1aa47u;
+
+    hash_bytes<CharT> const p = { text.data() };
+    std::size_t const len = text.size() * sizeof(CharT);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+
+    seed ^= hash_mix( seed ^ s0, s1 );
+
+    if ( len <= 16 )
+    {
+        if ( len >= 4 )
+        {
+            std::size_t const q = ( len >> 3 ) << 2;
+
+            a = p.r4( 0 ) << 32 | p.r4( q );
+            b = p.r4( len - 4 ) << 32 | p.r4( len - 4 - q );
+        }
+        else if ( len > 0 )
+        {
+            a = p.r3( len );
+        }
+    }
+    else
+    {
+        std::size_t i = 0;
+        std::size_t n = len;
+
+        if ( n > 48 )
+        {
+            std::uint64_t see1 = seed;
+            std::uint64_t see2 = seed;
+
+            do
+            {
+                seed = hash_mix( p.r8( i      ) ^ s1, p.r8( i +  8 ) ^ seed );
+                see1 = hash_mix( p.r8( i + 16 ) ^ s2, p.r8( i + 24 ) ^ see1 );
+                see2 = hash_mix( p.r8( i + 32 ) ^ s3, p.r8( i + 40 ) ^ see2 );
+                i += 48;
+                n -= 48;
+            } while ( n > 48 );
+
+            seed ^= see1 ^ see2;
+        }
+
+        for ( ; n > 16; i += 16, n -= 16 )
+        {
+            seed = hash_mix( p.r8( i ) ^ s1, p.r8( i + 8 ) ^ seed );
+        }
+
+        a = p.r8( i + n - 16 );
+        b = p.r8( i + n - 8 );
+    }
+
+    a ^= s1;
+    b ^= seed;
+    mul128( a, b );
+
+    return hash_mix( a ^ s0 ^ len, b ^ s1 );
+}
+
+// View on string, C-string or view, for transparent comparison:
+
+template< typename CharT >
+string_nodiscard std17::basic_string_view<CharT> as_view( std17::basic_string_view<CharT> text ) string_noexcept
+{
+    return text;
+}
+
+template< typename CharT >
+string_nodiscard std17::basic_string_view<CharT> as_view( CharT const * text ) string_noexcept
+{
+    return std17::basic_string_view<CharT>( text );
+}
+
+template< typename CharT, typename Traits, typename Allocator >
+string_nodiscard std17::basic_string_view<CharT> as_view( std::basic_string<CharT, Traits, Allocator> const & text ) string_noexcept
+{
+    return std17::basic_string_view<CharT>( text.data(), text.size() );
+}
+
+template< typename CharT >
+string_nodiscard std17::basic_string_view<CharT> as_view( basic_hashed_string_view<CharT> const & text ) string_noexcept
+{
+    return text.view();
+}
+
+} // namespace detail
+
+// String view with its hash(), computed once, at compile time for a constexpr view (C++14). Equality compares
+// the hashes first, string_hash and std::hash use the stored hash. Converts to string_view:
+
+template< typename CharT >
+class basic_hashed_string_view
+{
+public:
+    typedef std17::basic_string_view<CharT>             view_type;
+    typedef typename view_type::const_iterator          const_iterator;
+    typedef std::size_t                                 size_type;
+
+    string_constexpr14 basic_hashed_string_view() string_noexcept
+        : view_()
+        , hash_( detail::hash( view_type(), 0 ) )
+    {}
+
+    string_constexpr14 explicit basic_hashed_string_view( view_type text ) string_noexcept
+        : view_( text )
+        , hash_( detail::hash( text, 0 ) )
+    {}
+
+    explicit basic_hashed_string_view( CharT const * text ) string_noexcept
+        : view_( text )
+        , hash_( detail::hash( view_, 0 ) )
+    {}
+
+    template< typename Traits, typename Allocator >
+    explicit basic_hashed_string_view( std::basic_string<CharT, Traits, Allocator> const & text ) string_noexcept
+        : view_( text.data(), text.size() )
+        , hash_( detail::hash( view_, 0 ) )
+    {}
+
+    // text with its hash as computed by hash():
+
+    string_constexpr basic_hashed_string_view( view_type text, std::uint64_t hash_value ) string_noexcept
+        : view_( text )
+        , hash_( hash_value )
+    {}
+
+    string_nodiscard string_constexpr view_type     view() const string_noexcept { return view_; }
+    string_nodiscard string_constexpr std::uint64_t hash() const string_noexcept { return hash_; }
+
+    string_nodiscard string_constexpr operator view_type() const string_noexcept { return view_; }
+
+    string_nodiscard string_constexpr CharT const * data()  const string_noexcept { return view_.data(); }
+    string_nodiscard string_constexpr size_type     size()  const string_noexcept { return view_.size(); }
+    string_nodiscard string_constexpr bool          empty() const string_noexcept { return view_.empty(); }
+
+    string_nodiscard string_constexpr const_iterator begin() const string_noexcept { return view_.begin(); }
+    string_nodiscard string_constexpr const_iterator end()   const string_noexcept { return view_.end(); }
+
+    string_nodiscard friend bool operator==( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept
+    {
+        return a.hash_ == b.hash_ && a.view_ == b.view_;
+    }
+
+    string_nodiscard friend bool operator!=( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept
+    {
+        return !( a == b );
+    }
+
+    string_nodiscard friend bool operator==( basic_hashed_string_view const & a, view_type b ) string_noexcept { return a.view_ == b; }
+    string_nodiscard friend bool operator==( view_type a, basic_hashed_string_view const & b ) string_noexcept { return a == b.view_; }
+    string_nodiscard friend bool operator!=( basic_hashed_string_view const & a, view_type b ) string_noexcept { return !( a.view_ == b ); }
+    string_nodiscard friend bool operator!=( view_type a, basic_hashed_string_view const & b ) string_noexcept { return !( a == b.view_ ); }
+
+    string_nodiscard friend bool operator< ( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept { return a.view_.compare( b.view_ ) <  0; }
+    string_nodiscard friend bool operator<=( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept { return a.view_.compare( b.view_ ) <= 0; }
+    string_nodiscard friend bool operator> ( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept { return a.view_.compare( b.view_ ) >  0; }
+    string_nodiscard friend bool operator>=( basic_hashed_string_view const & a, basic_hashed_string_view const & b ) string_noexcept { return a.view_.compare( b.view_ ) >= 0; }
+
+private:
+    view_type     view_;
+    std::uint64_t hash_;
+};
+
+typedef basic_hashed_string_view<char> hashed_string_view;
+
+// Transparent hasher and equality for unordered containers of strings, to look up a string_view or C-string
+// without constructing a temporary key (heterogeneous lookup, C++20). The hash is that of hash():
+
+struct string_hash
+{
+    typedef void is_transparent;
+
+    template< typename CharT >
+    string_nodiscard std::size_t operator()( std17::basic_string_view<CharT> text ) const string_noexcept
+    {
+        return static_cast<std::size_t>( detail::hash( text, 0 ) );
+    }
+
+    template< typename CharT >
+    string_nodiscard std::size_t operator()( CharT const * text ) const string_noexcept
+    {
+        return (*this)( std17::basic_string_view<CharT>( text ) );
+    }
+
+    template< typename CharT, typename Traits, typename Allocator >
+    string_nodiscard std::size_t operator()( std::basic_string<CharT, Traits, Allocator> const & text ) const string_noexcept
+    {
+        return (*this)( std17::basic_string_view<CharT>( text.data(), text.size() ) );
+    }
+
+    template< typename CharT >
+    string_nodiscard std::size_t operator()( basic_hashed_string_view<CharT> const & text ) const string_noexcept
+    {
+        return static_cast<std::size_t>( text.hash() );
+    }
+};
+
+struct string_equal
+{
+    typedef void is_transparent;
+
+    template< typename L, typename R >
+    string_nodiscard bool operator()( L const & lhs, R const & rhs ) const string_noexcept
+    {
+        return detail::as_view( lhs ) == detail::as_view( rhs );
+    }
+
+    template< typename CharT >
+    string_nodiscard bool operator()( basic_hashed_string_view<CharT> const & lhs, basic_hashed_string_view<CharT> const & rhs ) const string_noexcept
+    {
+        return lhs == rhs;
+    }
+};
+
+namespace detail {
+
+// Equal views, in a constant expression also before C++17:
+
+template< typename CharT >
+string_nodiscard string_constexpr14 bool
+equal_chars( std17::basic_string_view<CharT> a, std17::basic_string_view<CharT> b ) string_noexcept
+{
+    if ( a.size() != b.size() )
+        return false;
+
+    for ( std::size_t i = 0; i < a.size(); ++i )
+    {
+        if ( a.data()[i] != b.data()[i] )
+            return false;
+    }
+    return true;
+}
+
+string_nodiscard inline string_constexpr std::size_t pow2_at_least( std::size_t n, std::size_t p = 1 ) string_noexcept
+{
+    return p >= n ? p : pow2_at_least( n, p * 2 );
+}
+
+} // namespace detail
+
+// Perfect hash of a fixed set of distinct keys, built at compile time for constexpr keys (C++14): index of a string
+// among the keys, or npos, with one hash() and one comparison. Keys are spread over buckets of two on average by
+// hash; for each bucket, largest first, a pilot value is sought that puts its keys in free slots of a table that
+// is at most half full (hash and displace):
+
+template< typename CharT, std::size_t N >
+class basic_string_switch
+{
+#if string_CPP11_OR_GREATER
+    static_assert( N > 0, "string_switch: at least one key" );
+#endif
+
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+    typedef std::size_t                     size_type;
+
+    string_constexpr14 explicit basic_string_switch( value_type const (&keys)[N] )
+        : keys_()
+        , pilots_()
+        , slots_()
+    {
+        std::uint64_t hashes[N] = {};
+        std::size_t   sizes[bucket_count] = {};
+        bool          taken[table_size] = {};
+        std::size_t   largest = 0;
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            keys_[i]  = keys[i];
+            hashes[i] = detail::hash( keys[i], 0 );
+
+            std::size_t const b = bucket_of( hashes[i] );
+
+            if ( ++sizes[b] > largest )
+                largest = sizes[b];
+        }
+
+        for ( std::size_t size = largest; size > 0; --size )
+        {
+            for ( std::size_t b = 0; b < bucket_count; ++b )
+            {
+                if ( sizes[b] == size )
+                    place( b, hashes, taken );
+            }
+        }
+    }
+
+    string_nodiscard string_constexpr14 size_type operator()( value_type text ) const string_noexcept
+    {
+        std::uint64_t const h = detail::hash( text, 0 );
+        std::size_t   const i = slots_[ slot_of( h, pilots_[ bucket_of( h ) ] ) ];
+
+        return detail::equal_chars( keys_[i], text ) ? i : size_type( npos );
+    }
+
+    string_nodiscard string_constexpr14 value_type operator[]( size_type i ) const string_noexcept { return keys_[i]; }
+
+    string_nodiscard string_constexpr size_type size() const string_noexcept { return N; }
+
+private:
+    typedef typename std::conditional< N <= 0xffffu, std::uint16_t, std::uint32_t >::type index_type;
+
+    enum : std::size_t
+    {
+        bucket_count = N / 2 + 1,
+        table_size   = detail::pow2_at_least( 2 * N ),
+        max_pilot    = 1u << 20,
+    };
+
+    static string_constexpr std::size_t bucket_of( std::uint64_t h ) string_noexcept
+    {
+        return static_cast<std::size_t>( ( ( h >> 32 ) * bucket_count ) >> 32 );
+    }
+
+    static string_constexpr14 std::size_t slot_of( std::uint64_t h, std::uint32_t pilot ) string_noexcept
+    {
+        return static_cast<std::size_t>( detail::hash_mix( h, 0x9e3779b97f4a7c15u ^ ( pilot * 0xbf58476d1ce4e5b9u ) ) & ( table_size - 1 ) );
+    }
+
+    // find the first pilot that puts the keys of bucket b in free slots:
+
+    string_constexpr14 void place( std::size_t b, std::uint64_t const * hashes, bool * taken )
+    {
+        std::size_t members[N] = {};
+        std::size_t count = 0;
+
+        for ( std::size_t i = 0; i < N; ++i )
+        {
+            if ( bucket_of( hashes[i] ) == b )
+                members[ count++ ] = i;
+        }
+
+        for ( std::uint32_t pilot = 0; pilot < max_pilot; ++pilot )
+        {
+            std::size_t placed = 0;
+
+            while ( placed < count && ! taken[ slot_of( hashes[ members[placed] ], pilot ) ] )
+            {
+                taken[ slot_of( hashes[ members[placed] ], pilot ) ] = true;
+                ++placed;
+            }
+
+            if ( placed == count )
+            {
+                for ( std::size_t k = 0; k < count; ++k )
+                    slots_[ slot_of( hashes[ members[k] ], pilot ) ] = static_cast<index_type>( members[k] );
+
+                pilots_[b] = pilot;
+                return;
+            }
+
+            while ( placed > 0 )
+            {
+                --placed;
+                taken[ slot_of( hashes[ members[placed] ], pilot ) ] = false;
+            }
+        }
+
+        // only keys with equal hashes do not fit:
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( false && "string_switch: keys must be distinct" );
+#else
+        throw std::invalid_argument("string_switch: keys must be distinct");
+#endif
+    }
+
+    value_type    keys_[N];
+    std::uint32_t pilots_[bucket_count];
+    index_type    slots_[table_size];   // key index, 0 if free
+};
+
+namespace detail {
+
+template< typename CharT, std::size_t... K >
+string_nodiscard string_constexpr14 basic_string_switch<CharT, sizeof...(K)>
+make_string_switch( CharT const (&... keys)[K] )
+{
+    std17::basic_string_view<CharT> const views[] = { std17::basic_string_view<CharT>( keys, K - 1 )... };
+
+    return basic_string_switch<CharT, sizeof...(K)>( views );
+}
+
+#if string_HAVE_CLASS_NTTP
+
+// String literal as template argument:
+
+template< typename CharT, std::size_t N >
+struct fixed_string
+{
+    CharT chars[N];
+
+    constexpr fixed_string( CharT const (&text)[N] )
+        : chars()
+    {
+        for ( std::size_t i = 0; i < N; ++i )
+            chars[i] = text[i];
+    }
+};
+
+#endif // string_HAVE_CLASS_NTTP
+
+} // namespace detail
+
+#if string_HAVE_CLASS_NTTP
+
+// string_switch<"GET", "POST", ...>( text ): index of text among the keys, or npos (C++20):
+
+template< detail::fixed_string... Keys >
+inline constexpr auto string_switch = detail::make_string_switch( Keys.chars... );
+
+#endif // string_HAVE_CLASS_NTTP
+
+} // namespace string
+
+// hash() -> 64-bit hash, the same on all platforms
+
+#define string_MK_HASH(CharT)                                                                       \
+    string_nodiscard inline string_constexpr14 std::uint64_t                                        \
+    hash(                                                                                           \
+        std17::basic_string_view<CharT> text                                                        \
+        , std::uint64_t seed = 0 ) string_noexcept                                                  \
+    {                                                                                               \
+        return detail::hash( text, seed );                                                          \
+    }
+
+// make_string_switch() -> perfect hash of string literals
+
+#define string_MK_MAKE_STRING_SWITCH(CharT)                                                         \
+    template< std::size_t... K >                                                                    \
+    string_nodiscard string_constexpr14 basic_string_switch<CharT, sizeof...(K)>                    \
+    make_string_switch( CharT const (&... keys)[K] )                                                \
+    {                                                                                               \
+        return detail::make_string_switch<CharT>( keys... );                                        \
+    }
+
+//
+// Interning:
+//
+
+namespace string {
+namespace detail {
+
+// Characters in chunks that never move, so that views on stored strings stay valid; a string longer than the chunk
+// size gets a chunk of its own:
+
+template< typename CharT >
+class char_arena
+{
+public:
+    explicit char_arena( std::size_t chunk_size )
+        : chunks_()
+        , chunk_size_( (std::max)( chunk_size, std::size_t( 1 ) ) )
+        , current_( string_nullptr )
+        , avail_( 0 )
+        , used_( 0 )
+        , reserved_( 0 )
+    {}
+
+    CharT * store( std17::basic_string_view<CharT> text )
+    {
+        std::size_t const n = text.size();
+        CharT * p = string_nullptr;
+
+        if ( n > chunk_size_ )
+        {
+            p = add_chunk( n );
+        }
+        else
+        {
+            if ( n > avail_ )
+            {
+                current_ = add_chunk( chunk_size_ );
+                avail_   = chunk_size_;
+            }
+            p = current_;
+            current_ += n;
+            avail_   -= n;
+        }
+
+        std::copy( text.begin(), text.end(), p );
+        used_ += n;
+        return p;
+    }
+
+    void clear()
+    {
+        chunks_.clear();
+        current_  = string_nullptr;
+        avail_    = 0;
+        used_     = 0;
+        reserved_ = 0;
+    }
+
+    string_nodiscard std::size_t used()     const string_noexcept { return used_; }
+    string_nodiscard std::size_t reserved() const string_noexcept { return reserved_; }
+
+private:
+    CharT * add_chunk( std::size_t n )
+    {
+        chunks_.push_back( std::unique_ptr<CharT[]>( new CharT[n] ) );
+        reserved_ += n;
+        return chunks_.back().get();
+    }
+
+    std::vector< std::unique_ptr<CharT[]> > chunks_;
+    std::size_t chunk_size_;
+    CharT *     current_;       // free part of the last regular chunk
+    std::size_t avail_;
+    std::size_t used_;
+    std::size_t reserved_;
+};
+
+} // namespace detail
+
+// Pool of unique strings with dense 32-bit ids: id to string_view in O(1) via a vector of views into the arena,
+// string to id in amortized O(1) via an open-addressing table of 32-bit hash and id, probed linearly. Views stay
+// valid until clear() or destruction of the pool:
+
+template< typename CharT >
+class basic_intern_pool
+{
+public:
+    typedef std17::basic_string_view<CharT>                    value_type;
+    typedef std::uint32_t                                      id_type;
+    typedef std::size_t                                        size_type;
+    typedef typename std::vector<value_type>::const_iterator   const_iterator;
+    typedef const_iterator                                     iterator;
+
+    struct statistics
+    {
+        size_type strings;          // unique strings
+        size_type characters;       // characters stored
+        size_type arena_bytes;      // allocated for characters
+        size_type index_bytes;      // allocated for id to string and string to id
+    };
+
+    // chunk size in characters:
+
+    explicit basic_intern_pool( size_type chunk_size = 65536 / sizeof(CharT) )
+        : arena_( chunk_size )
+        , strings_()
+        , slots_()
+    {}
+
+    // id of text, stored as a new string if not present:
+
+    id_type intern( value_type text )
+    {
+        if ( ( strings_.size() + 1 ) * 4 > slots_.size() * 3 )
+            rehash( (std::max)( slots_.size() * 2, size_type( 16 ) ) );
+
+        std::uint32_t const h = hash32( text );
+        std::size_t i = h & mask();
+
+        for ( ; slots_[i].id != 0; i = ( i + 1 ) & mask() )
+        {
+            if ( slots_[i].hash == h && strings_[ slots_[i].id - 1 ] == text )
+                return slots_[i].id - 1;
+        }
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( strings_.size() < max_size() );
+#else
+        if ( strings_.size() >= max_size() )
+        {
+            throw std::length_error("intern(): more than 4G - 1 strings");
+        }
+#endif
+        id_type const id = static_cast<id_type>( strings_.size() );
+
+        strings_.push_back( value_type( arena_.store( text ), text.size() ) );
+        slots_[i].hash = h;
+        slots_[i].id   = id + 1;
+
+        return id;
+    }
+
+    // ids of the strings of a range, such as from split() or split_view():
+
+    template< typename Range >
+    typename std::enable_if< ! std::is_convertible<Range const &, value_type>::value, std::vector<id_type> >::type
+    intern( Range const & texts )
+    {
+        std::vector<id_type> ids;
+
+        for ( auto pos = texts.begin(); pos != texts.end(); ++pos )
+            ids.push_back( intern( value_type( *pos ) ) );
+
+        return ids;
+    }
+
+    string_nodiscard bool find( value_type text, id_type & id ) const
+    {
+        if ( slots_.empty() )
+            return false;
+
+        std::uint32_t const h = hash32( text );
+
+        for ( std::size_t i = h & mask(); slots_[i].id != 0; i = ( i + 1 ) & mask() )
+        {
+            if ( slots_[i].hash == h && strings_[ slots_[i].id - 1 ] == text )
+            {
+                id = slots_[i].id - 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    string_nodiscard value_type operator[]( id_type id ) const { return strings_[id]; }
+
+    string_nodiscard size_type size()  const string_noexcept { return strings_.size(); }
+    string_nodiscard bool      empty() const string_noexcept { return strings_.empty(); }
+
+    string_nodiscard const_iterator begin() const { return strings_.begin(); }
+    string_nodiscard const_iterator end()   const { return strings_.end(); }
+
+    void reserve( size_type n )
+    {
+        strings_.reserve( n );
+
+        size_type slots = 16;
+        while ( slots * 3 < n * 4 )
+            slots *= 2;
+
+        if ( slots > slots_.size() )
+            rehash( slots );
+    }
+
+    void clear()
+    {
+        arena_.clear();
+        strings_.clear();
+        slots_.clear();
+    }
+
+    string_nodiscard statistics stats() const
+    {
+        statistics const result =
+        {
+            strings_.size()
+            , arena_.used()
+            , arena_.reserved() * sizeof(CharT)
+            , strings_.capacity() * sizeof(value_type) + slots_.capacity() * sizeof(slot)
+        };
+        return result;
+    }
+
+    static string_constexpr size_type max_size() string_noexcept { return 0xfffffffeu; }
+
+private:
+    struct slot
+    {
+        std::uint32_t hash;
+        std::uint32_t id;       // id + 1, 0 if empty
+    };
+
+    static std::uint32_t hash32( value_type text ) string_noexcept
+    {
+        return static_cast<std::uint32_t>( detail::hash( text, 0 ) );
+    }
+
+    std::size_t mask() const string_noexcept
+    {
+        return slots_.size() - 1;
+    }
+
+    // move entries to a table of given power-of-two size, positioned by their stored hash:
+
+    void rehash( size_type size )
+    {
+        slot const empty = { 0, 0 };
+        std::vector<slot> slots( size, empty );
+
+        for ( std::size_t k = 0; k < slots_.size(); ++k )
+        {
+            if ( slots_[k].id == 0 )
+                continue;
+
+            std::size_t i = slots_[k].hash & ( size - 1 );
+
+            while ( slots[i].id != 0 )
+                i = ( i + 1 ) & ( size - 1 );
+
+            slots[i] = slots_[k];
+        }
+        slots_.swap( slots );
+    }
+
+    detail::char_arena<CharT>   arena_;
+    std::vector<value_type>     strings_;   // by id
+    std::vector<slot>           slots_;
+};
+
+typedef basic_intern_pool<char> intern_pool;
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// Pool of unique strings for concurrent use, with dense 32-bit ids. Looking up a present string takes no lock:
+// strings are spread over shards by hash, each with an open-addressing table of atomic 64-bit slots (hash, id + 1),
+// which is replaced by a larger copy when 3/4 full; replaced tables are kept for readers until destruction.
+// Inserting a string takes the lock of its shard only. Views are kept in segments of doubling size that never move.
+// An id is valid for operator[] once it is returned by intern() or find():
+
+template< typename CharT >
+class basic_concurrent_intern_pool
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+    typedef std::uint32_t                   id_type;
+    typedef std::size_t                     size_type;
+
+    // shard count is rounded up to a power of two, chunk size is in characters:
+
+    explicit basic_concurrent_intern_pool( size_type shard_count = 64, size_type chunk_size = 65536 / sizeof(CharT) )
+        : shards_()
+        , shard_mask_( 0 )
+        , next_id_( 0 )
+    {
+        size_type n = 1;
+        while ( n < shard_count )
+            n *= 2;
+
+        shard_mask_ = n - 1;
+
+        for ( size_type i = 0; i < n; ++i )
+            shards_.push_back( std::unique_ptr<shard>( new shard( chunk_size ) ) );
+
+        for ( size_type k = 0; k < segment_count; ++k )
+            segments_[k].store( string_nullptr, std::memory_order_relaxed );
+    }
+
+    basic_concurrent_intern_pool( basic_concurrent_intern_pool const & ) = delete;
+    basic_concurrent_intern_pool & operator=( basic_concurrent_intern_pool const & ) = delete;
+
+    ~basic_concurrent_intern_pool()
+    {
+        for ( size_type k = 0; k < segment_count; ++k )
+            delete [] segments_[k].load( std::memory_order_relaxed );
+    }
+
+    // id of text, stored as a new string if not present:
+
+    id_type intern( value_type text )
+    {
+        std::uint64_t const h = detail::hash( text, 0 );
+        shard & s = *shards_[ ( h >> 40 ) & shard_mask_ ];
+
+        id_type id = 0;
+
+        if ( lookup( s.current.load( std::memory_order_acquire ), static_cast<std::uint32_t>( h ), text, id ) )
+            return id;
+
+        std::lock_guard<std::mutex> lock( s.mutex );
+
+        return insert( s, static_cast<std::uint32_t>( h ), text );
+    }
+
+    string_nodiscard bool find( value_type text, id_type & id ) const
+    {
+        std::uint64_t const h = detail::hash( text, 0 );
+        shard const & s = *shards_[ ( h >> 40 ) & shard_mask_ ];
+
+        return lookup( s.current.load( std::memory_order_acquire ), static_cast<std::uint32_t>( h ), text, id );
+    }
+
+    string_nodiscard value_type operator[]( id_type id ) const
+    {
+        size_type const k = segment_of( id );
+
+        return segments_[k].load( std::memory_order_acquire )[ id - segment_first( k ) ];
+    }
+
+    // number of ids handed out, including those of strings that are being inserted:
+
+    string_nodiscard size_type size() const string_noexcept { return next_id_.load( std::memory_order_acquire ); }
+
+    static string_constexpr size_type max_size() string_noexcept { return 0xfffffffeu; }
+
+private:
+    enum : size_type { segment_base = 1024, segment_count = 23 };   // 1024 * ( 2^23 - 1 ) ids >= max_size()
+
+    struct table
+    {
+        size_type                                     mask;
+        std::unique_ptr< std::atomic<std::uint64_t>[] > slots;
+
+        explicit table( size_type size )
+            : mask( size - 1 )
+            , slots( new std::atomic<std::uint64_t>[ size ] )
+        {
+            for ( size_type i = 0; i < size; ++i )
+                slots[i].store( 0, std::memory_order_relaxed );
+        }
+    };
+
+    struct shard
+    {
+        std::mutex                              mutex;
+        std::atomic<table *>                    current;
+        std::vector< std::unique_ptr<table> >   tables;     // current and replaced ones
+        size_type                               count;
+        detail::char_arena<CharT>               arena;
+
+        explicit shard( size_type chunk_size )
+            : mutex()
+            , current( string_nullptr )
+            , tables()
+            , count( 0 )
+            , arena( chunk_size )
+        {}
+    };
+
+    static size_type segment_of( id_type id ) string_noexcept
+    {
+        return static_cast<size_type>( detail::log2_64( id / segment_base + 1u ) );
+    }
+
+    static size_type segment_first( size_type k ) string_noexcept
+    {
+        return segment_base * ( ( size_type( 1 ) << k ) - 1 );
+    }
+
+    bool lookup( table const * t, std::uint32_t h, value_type text, id_type & id ) const
+    {
+        if ( t == string_nullptr )
+            return false;
+
+        for ( size_type i = h & t->mask; ; i = ( i + 1 ) & t->mask )
+        {
+            std::uint64_t const slot = t->slots[i].load( std::memory_order_acquire );
+
+            if ( slot == 0 )
+                return false;
+
+            if ( static_cast<std::uint32_t>( slot >> 32 ) == h && (*this)[ static_cast<id_type>( slot ) - 1 ] == text )
+            {
+                id = static_cast<id_type>( slot ) - 1;
+                return true;
+            }
+        }
+    }
+
+    // with the shard locked:
+
+    id_type insert( shard & s, std::uint32_t h, value_type text )
+    {
+        table * t = s.current.load( std::memory_order_relaxed );
+        id_type id = 0;
+
+        if ( lookup( t, h, text, id ) )
+            return id;
+
+        if ( t == string_nullptr || ( s.count + 1 ) * 4 > ( t->mask + 1 ) * 3 )
+            t = grow( s );
+
+        size_type const next = next_id_.fetch_add( 1, std::memory_order_relaxed );
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( next < max_size() );
+#else
+        if ( next >= max_size() )
+        {
+            next_id_.fetch_sub( 1, std::memory_order_relaxed );
+            throw std::length_error("intern(): more than 4G - 1 strings");
+        }
+#endif
+        id = static_cast<id_type>( next );
+
+        size_type const k = segment_of( id );
+        segment( k )[ id - segment_first( k ) ] = value_type( s.arena.store( text ), text.size() );
+
+        size_type i = h & t->mask;
+        while ( t->slots[i].load( std::memory_order_relaxed ) != 0 )
+            i = ( i + 1 ) & t->mask;
+
+        t->slots[i].store( std::uint64_t( h ) << 32 | ( id + 1u ), std::memory_order_release );
+        ++s.count;
+
+        return id;
+    }
+
+    // publish a copy of the shard's table of twice the size:
+
+    table * grow( shard & s )
+    {
+        table const * const old = s.current.load( std::memory_order_relaxed );
+        std::unique_ptr<table> t( new table( old != string_nullptr ? ( old->mask + 1 ) * 2 : 16 ) );
+
+        for ( size_type k = 0; old != string_nullptr && k <= old->mask; ++k )
+        {
+            std::uint64_t const slot = old->slots[k].load( std::memory_order_relaxed );
+
+            if ( slot == 0 )
+                continue;
+
+            size_type i = static_cast<std::uint32_t>( slot >> 32 ) & t->mask;
+            while ( t->slots[i].load( std::memory_order_relaxed ) != 0 )
+                i = ( i + 1 ) & t->mask;
+
+            t->slots[i].store( slot, std::memory_order_relaxed );
+        }
+
+        table * const result = t.get();
+        s.tables.push_back( std::move( t ) );
+        s.current.store( result, std::memory_order_release );
+
+        return result;
+    }
+
+    // segment k, allocated by the first shard that needs it:
+
+    value_type * segment( size_type k )
+    {
+        value_type * seg = segments_[k].load( std::memory_order_acquire );
+
+        if ( seg != string_nullptr )
+            return seg;
+
+        std::unique_ptr<value_type[]> fresh( new value_type[ segment_base << k ] );
+
+        if ( segments_[k].compare_exchange_strong( seg, fresh.get(), std::memory_order_acq_rel ) )
+            return fresh.release();
+
+        return seg;
+    }
+
+    std::vector< std::unique_ptr<shard> >       shards_;
+    size_type                                   shard_mask_;
+    std::atomic<size_type>                      next_id_;
+    std::atomic<value_type *>                   segments_[ segment_count ];
+};
+
+typedef basic_concurrent_intern_pool<char> concurrent_intern_pool;
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+} // namespace string
+
+//
+// Prefix and suffix sets:
+//
+
+namespace string {
+
+// Set of keys as a radix tree in flat arrays: nodes with an edge label of one or more characters in a single
+// character buffer, children of a node contiguous and ordered by the first character of their label, which is
+// also kept in an array of its own to select a child by scanning a few bytes. With Reverse, keys are stored
+// reversed to match at the end of text. Built once from a range of strings:
+
+template< typename CharT, bool Reverse = false >
+class basic_prefix_set
+{
+public:
+    typedef std17::basic_string_view<CharT> value_type;
+    typedef std::size_t                     size_type;
+
+    basic_prefix_set()
+        : nodes_( 1, node() )
+        , first_( 1, CharT() )
+        , chars_()
+        , size_( 0 )
+    {}
+
+    template< typename Range >
+    explicit basic_prefix_set( Range const & keys )
+        : nodes_()
+        , first_()
+        , chars_()
+        , size_( 0 )
+    {
+        std::vector< std::basic_string<CharT> > sorted;
+
+        for ( auto pos = keys.begin(); pos != keys.end(); ++pos )
+        {
+            value_type const key( *pos );
+            sorted.push_back( Reverse ? std::basic_string<CharT>( key.rbegin(), key.rend() ) : std::basic_string<CharT>( key.begin(), key.end() ) );
+        }
+        build( sorted );
+    }
+
+    basic_prefix_set( std::initializer_list<value_type> keys )
+        : nodes_()
+        , first_()
+        , chars_()
+        , size_( 0 )
+    {
+        std::vector< std::basic_string<CharT> > sorted;
+
+        for ( value_type const & key : keys )
+            sorted.push_back( Reverse ? std::basic_string<CharT>( key.rbegin(), key.rend() ) : std::basic_string<CharT>( key.begin(), key.end() ) );
+
+        build( sorted );
+    }
+
+    // length of the longest key that text starts with (ends with, if Reverse), or npos:
+
+    string_nodiscard size_type longest_match( value_type text ) const
+    {
+        size_type best = npos;
+        size_type pos  = 0;
+
+        for ( std::uint32_t n = 0; ; )
+        {
+            if ( nodes_[n].terminal )
+                best = pos;
+
+            if ( pos == text.size() )
+                break;
+
+            std::uint32_t const c = child( nodes_[n], at( text, pos ) );
+
+            if ( c == 0 || ! label_matches( nodes_[c], text, pos ) )
+                break;
+
+            pos += nodes_[c].length;
+            n = c;
+        }
+        return best;
+    }
+
+    string_nodiscard bool matches( value_type text ) const
+    {
+        return longest_match( text ) != npos;
+    }
+
+    // text is one of the keys:
+
+    string_nodiscard bool contains( value_type key ) const
+    {
+        size_type pos = 0;
+        std::uint32_t n = 0;
+
+        while ( pos < key.size() )
+        {
+            std::uint32_t const c = child( nodes_[n], at( key, pos ) );
+
+            if ( c == 0 || ! label_matches( nodes_[c], key, pos ) )
+                return false;
+
+            pos += nodes_[c].length;
+            n = c;
+        }
+        return nodes_[n].terminal;
+    }
+
+    string_nodiscard size_type size()  const string_noexcept { return size_; }
+    string_nodiscard bool      empty() const string_noexcept { return size_ == 0; }
+
+private:
+    struct node
+    {
+        std::uint32_t label;        // offset of edge label in chars_
+        std::uint32_t length;       // of edge label, 0 for the root only
+        std::uint32_t children;     // index of first child, 0 if none
+        std::uint32_t count;        // number of children
+        bool          terminal;     // a key ends here
+
+        node()
+            : label( 0 ), length( 0 ), children( 0 ), count( 0 ), terminal( false ) {}
+    };
+
+    static CharT at( value_type text, size_type pos )
+    {
+        return Reverse ? text.data()[ text.size() - 1 - pos ] : text.data()[ pos ];
+    }
+
+    bool label_matches( node const & nd, value_type text, size_type pos ) const
+    {
+        if ( nd.length > text.size() - pos )
+            return false;
+
+        for ( size_type k = 1; k < nd.length; ++k )     // first character selected the node
+        {
+            if ( chars_[ nd.label + k ] != at( text, pos + k ) )
+                return false;
+        }
+        return true;
+    }
+
+    // child with label starting with chr, 0 if none; children are in std::basic_string order, so compare as
+    // char_traits does, e.g. char as unsigned char:
+
+    std::uint32_t child( node const & nd, CharT chr ) const
+    {
+        CharT const * const first = first_.data() + nd.children;
+        CharT const * const last  = first + nd.count;
+        CharT const *       pos   = first;
+
+        if ( nd.count <= 16 )
+        {
+            while ( pos != last && *pos != chr )
+                ++pos;
+        }
+        else
+        {
+            pos = std::lower_bound( first, last, chr, []( CharT a, CharT b ) { return std::char_traits<CharT>::lt( a, b ); } );
+        }
+
+        return pos != last && *pos == chr ? nd.children + static_cast<std::uint32_t>( pos - first ) : 0;
+    }
+
+    void build( std::vector< std::basic_string<CharT> > & keys )
+    {
+        std::sort( keys.begin(), keys.end() );
+        keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+        size_ = keys.size();
+        nodes_.assign( 1, node() );
+        first_.assign( 1, CharT() );
+
+        build( keys, 0, 0, keys.size(), 0 );
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( chars_.size() <= 0xffffffffu && nodes_.size() <= 0xffffffffu );
+#else
+        if ( chars_.size() > 0xffffffffu || nodes_.size() > 0xffffffffu )
+        {
+            throw std::length_error("prefix_set: keys of 4G characters or more");
+        }
+#endif
+    }
+
+    // keys [lo, hi) share their first depth characters and belong to node n:
+
+    void build( std::vector< std::basic_string<CharT> > const & keys, std::uint32_t n, size_type lo, size_type hi, size_type depth )
+    {
+        if ( lo < hi && keys[lo].size() == depth )
+        {
+            nodes_[n].terminal = true;
+            ++lo;
+        }
+
+        // children: one per group of keys with the same next character, added together:
+
+        std::uint32_t const children = static_cast<std::uint32_t>( nodes_.size() );
+        std::vector<size_type> groups;
+
+        for ( size_type i = lo; i < hi; ++i )
+        {
+            if ( i == lo || keys[i][depth] != keys[i - 1][depth] )
+                groups.push_back( i );
+        }
+        groups.push_back( hi );
+
+        nodes_[n].children = groups.size() > 1 ? children : 0;
+        nodes_[n].count    = static_cast<std::uint32_t>( groups.size() - 1 );
+
+        nodes_.resize( nodes_.size() + groups.size() - 1 );
+        first_.resize( nodes_.size() );
+
+        for ( size_type g = 0; g + 1 < groups.size(); ++g )
+        {
+            std::basic_string<CharT> const & first = keys[ groups[g] ];
+            std::basic_string<CharT> const & last  = keys[ groups[g + 1] - 1 ];
+
+            // label: common prefix of the group, which is that of its first and last key as they are sorted:
+
+            size_type end = depth + 1;
+            while ( end < first.size() && end < last.size() && first[end] == last[end] )
+                ++end;
+
+            std::uint32_t const c = children + static_cast<std::uint32_t>( g );
+
+            nodes_[c].label  = static_cast<std::uint32_t>( chars_.size() );
+            nodes_[c].length = static_cast<std::uint32_t>( end - depth );
+            first_[c]        = first[depth];
+            chars_.append( first, depth, end - depth );
+
+            build( keys, c, groups[g], groups[g + 1], end );
+        }
+    }
+
+    std::vector<node>        nodes_;    // root at 0
+    std::vector<CharT>       first_;    // first character of the label of each node
+    std::basic_string<CharT> chars_;    // edge labels
+    size_type                size_;
+};
+
+template< typename CharT >
+using basic_suffix_set = basic_prefix_set<CharT, true>;
+
+typedef basic_prefix_set<char>  prefix_set;
+typedef basic_suffix_set<char>  suffix_set;
+
+} // namespace string
+
+// longest_prefix_match(), starts_with_any(), longest_suffix_match(), ends_with_any()
+
+#define string_MK_PREFIX_SET(CharT)                                                                 \
+    string_nodiscard inline std::size_t                                                             \
+    longest_prefix_match( std17::basic_string_view<CharT> text, basic_prefix_set<CharT> const & set ) \
+    {                                                                                               \
+        return set.longest_match( text );                                                           \
+    }                                                                                               \
+                                                                                                    \
+    string_nodiscard inline bool                                                                    \
+    starts_with_any( std17::basic_string_view<CharT> text, basic_prefix_set<CharT> const & set )    \
+    {                                                                                               \
+        return set.matches( text );                                                                 \
+    }                                                                                               \
+                                                                                                    \
+    string_nodiscard inline std::size_t                                                             \
+    longest_suffix_match( std17::basic_string_view<CharT> text, basic_suffix_set<CharT> const & set ) \
+    {                                                                                               \
+        return set.longest_match( text );                                                           \
+    }                                                                                               \
+                                                                                                    \
+    string_nodiscard inline bool                                                                    \
+    ends_with_any( std17::basic_string_view<CharT> text, basic_suffix_set<CharT> const & set )      \
+    {                                                                                               \
+        return set.matches( text );                                                                 \
+    }
+
+//
+// Sorting:
+//
+
+namespace string {
+namespace detail {
+
+// Order of a character as by char_traits: char compares as unsigned char, other character types by value:
+
+string_nodiscard inline std::uint64_t char_order( char chr ) string_noexcept
+{
+    return static_cast<unsigned char>( chr );
+}
+
+template< typename CharT >
+string_nodiscard std::uint64_t char_order( CharT chr ) string_noexcept
+{
+    typedef typename std::make_unsigned<CharT>::type unsigned_type;
+
+    return std::is_signed<CharT>::value
+        ? static_cast<unsigned_type>( static_cast<unsigned_type>( chr ) ^ static_cast<unsigned_type>( unsigned_type( 1 ) << ( 8 * sizeof( CharT ) - 1 ) ) )
+        : static_cast<unsigned_type>( chr );
+}
+
+// Sorts the strings [lo, lo + n) that have their first depth characters in common by the characters that follow:
+// MSD radix sort of byte strings with the character at depth of each string cached in an array while it is
+// permuted in place (American flag sort) after skipping the prefix all strings share, multikey quicksort for
+// smaller ranges and wider characters, and insertion sort that compares from depth on for the smallest. The largest part of a range is sorted by
+// iteration and the others by recursion, so that recursion is at most log2(n) deep:
+
+template< typename RandomIt >
+class string_sorter
+{
+public:
+    typedef decltype( as_view( *std::declval<RandomIt>() ) )            view_type;
+    typedef typename view_type::value_type                              char_type;
+    typedef typename view_type::traits_type                             traits_type;
+    typedef typename std::iterator_traits<RandomIt>::difference_type    difference_type;
+
+    enum { buckets = 257 };     // end of string and 256 characters, higher ones as the last
+
+    explicit string_sorter( RandomIt first )
+        : first_( first )
+        , cache_()
+    {}
+
+    void sort( std::size_t lo, std::size_t n, std::size_t depth )
+    {
+        while ( n > 1 )
+        {
+            if ( n <= insertion_limit )
+            {
+                insertion_sort( lo, n, depth );
+                return;
+            }
+
+            if ( sizeof( char_type ) == 1 && n >= radix_limit )
+            {
+                depth += common_prefix( lo, n, depth );
+
+                std::size_t ends[ buckets ];
+                distribute( lo, n, depth, ends );
+
+                std::size_t largest = 1;
+                for ( std::size_t b = 2; b < buckets; ++b )
+                {
+                    if ( ends[b] - ends[b - 1] > ends[largest] - ends[largest - 1] )
+                        largest = b;
+                }
+
+                for ( std::size_t b = 1; b < buckets; ++b )     // bucket 0: strings that end at depth
+                {
+                    if ( b != largest )
+                        sort( ends[b - 1], ends[b] - ends[b - 1], depth + 1 );
+                }
+
+                lo     = ends[largest - 1];
+                n      = ends[largest] - lo;
+                depth += 1;
+            }
+            else
+            {
+                std::uint64_t const pivot = median( key( lo, depth ), key( lo + n / 2, depth ), key( lo + n - 1, depth ) );
+
+                std::size_t lt = lo;
+                std::size_t gt = lo + n;
+
+                for ( std::size_t i = lo; i < gt; )
+                {
+                    std::uint64_t const k = key( i, depth );
+
+                    if      ( k < pivot ) { swap( lt++, i++ ); }
+                    else if ( k > pivot ) { swap( i, --gt ); }
+                    else                  { ++i; }
+                }
+
+                // [lo, lt) less than, [lt, gt) equal to and [gt, lo + n) greater than pivot at depth:
+
+                std::size_t const n_lt = lt - lo;
+                std::size_t const n_eq = pivot != 0 ? gt - lt : 0;
+                std::size_t const n_gt = lo + n - gt;
+
+                if ( n_lt >= n_eq && n_lt >= n_gt )
+                {
+                    sort( lt, n_eq, depth + 1 );
+                    sort( gt, n_gt, depth );
+                    n = n_lt;
+                }
+                else if ( n_eq >= n_gt )
+                {
+                    sort( lo, n_lt, depth );
+                    sort( gt, n_gt, depth );
+                    lo     = lt;
+                    n      = n_eq;
+                    depth += 1;
+                }
+                else
+                {
+                    sort( lo, n_lt, depth );
+                    sort( lt, n_eq, depth + 1 );
+                    lo = gt;
+                    n  = n_gt;
+                }
+            }
+        }
+    }
+
+    // strings [lo, lo + n) into buckets by character at depth; bucket b ends at ends[b]:
+
+    void distribute( std::size_t lo, std::size_t n, std::size_t depth, std::size_t (&ends)[ buckets ] )
+    {
+        std::size_t next[ buckets ] = {};
+
+        if ( cache_.size() < n )
+            cache_.resize( n );
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            std::uint64_t const k = (std::min)( key( lo + i, depth ), std::uint64_t( buckets - 1 ) );
+
+            cache_[i] = static_cast<std::uint16_t>( k );
+            ++next[k];
+        }
+
+        for ( std::size_t b = 0, pos = lo; b < buckets; ++b )
+        {
+            pos    += next[b];
+            ends[b] = pos;
+            next[b] = pos - next[b];
+        }
+
+        for ( std::size_t b = 0; b < buckets; ++b )
+        {
+            for ( ; next[b] < ends[b]; ++next[b] )
+            {
+                std::size_t const i = next[b];
+
+                for ( std::size_t k = cache_[i - lo]; k != b; k = cache_[i - lo] )
+                {
+                    std::size_t const j = next[k]++;
+
+                    swap( i, j );
+                    std::swap( cache_[i - lo], cache_[j - lo] );
+                }
+            }
+        }
+    }
+
+    // the strings of bucket b have their character at depth in common:
+
+    static bool is_exact( std::size_t b ) string_noexcept
+    {
+        return sizeof( char_type ) == 1 || b < buckets - 1;
+    }
+
+private:
+    enum { insertion_limit = 16 };
+    enum { radix_limit = 1024 };
+
+    RandomIt at( std::size_t i ) const
+    {
+        return first_ + static_cast<difference_type>( i );
+    }
+
+    std::uint64_t key( std::size_t i, std::size_t depth ) const
+    {
+        view_type const text = as_view( *at( i ) );
+
+        return depth < text.size() ? 1 + char_order( text.data()[depth] ) : 0;
+    }
+
+    void swap( std::size_t i, std::size_t j )
+    {
+        std::iter_swap( at( i ), at( j ) );
+    }
+
+    static std::uint64_t median( std::uint64_t a, std::uint64_t b, std::uint64_t c ) string_noexcept
+    {
+        return a < b ? ( b < c ? b : (std::max)( a, c ) ) : ( a < c ? a : (std::max)( b, c ) );
+    }
+
+    bool less( std::size_t i, std::size_t j, std::size_t depth ) const
+    {
+        view_type const a = as_view( *at( i ) );
+        view_type const b = as_view( *at( j ) );
+
+        int const result = traits_type::compare( a.data() + depth, b.data() + depth, (std::min)( a.size(), b.size() ) - depth );
+
+        return result < 0 || ( result == 0 && a.size() < b.size() );
+    }
+
+    // length of the prefix that all strings [lo, lo + n) have in common after depth:
+
+    std::size_t common_prefix( std::size_t lo, std::size_t n, std::size_t depth ) const
+    {
+        view_type const first = as_view( *at( lo ) );
+        std::size_t length = first.size() - depth;
+
+        for ( std::size_t i = lo + 1; i < lo + n && length > 0; ++i )
+        {
+            view_type const text = as_view( *at( i ) );
+            std::size_t k = 0;
+
+            length = (std::min)( length, text.size() - depth );
+
+            while ( k < length && traits_type::eq( first.data()[depth + k], text.data()[depth + k] ) )
+                ++k;
+
+            length = k;
+        }
+        return length;
+    }
+
+    void insertion_sort( std::size_t lo, std::size_t n, std::size_t depth )
+    {
+        for ( std::size_t i = lo + 1; i < lo + n; ++i )
+        {
+            for ( std::size_t j = i; j > lo && less( j, j - 1, depth ); --j )
+                swap( j, j - 1 );
+        }
+    }
+
+    RandomIt                   first_;
+    std::vector<std::uint16_t> cache_;      // bucket of each string in distribute()
+};
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// Ranges are distributed into buckets by the threads until they are small enough to sort with one, largest
+// first; a range that all goes into one bucket of wide characters is sorted at once:
+
+template< typename RandomIt >
+void sort_strings_parallel( RandomIt first, std::size_t n, unsigned thread_count )
+{
+    typedef string_sorter<RandomIt> sorter_type;
+
+    struct task
+    {
+        std::size_t lo, n, depth;
+
+        bool operator<( task const & other ) const { return n < other.n; }
+    };
+
+    std::size_t const split_limit = (std::max)( n / ( 8 * thread_count ), std::size_t( 1 ) << 14 );
+
+    std::vector<task> tasks( 1, task{ 0, n, 0 } );
+    std::size_t busy = 0;
+    std::mutex  mutex;
+
+    auto worker = [&]()
+    {
+        sorter_type sorter( first );
+        std::vector<task> parts;
+
+        for ( ;; )
+        {
+            task current = { 0, 0, 0 };
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+
+                if ( tasks.empty() && busy == 0 )
+                    return;
+
+                if ( ! tasks.empty() )
+                {
+                    current = tasks.back();
+                    tasks.pop_back();
+                    ++busy;
+                }
+            }
+
+            if ( current.n == 0 )
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            parts.clear();
+
+            if ( current.n > split_limit )
+            {
+                std::size_t ends[ sorter_type::buckets ];
+                sorter.distribute( current.lo, current.n, current.depth, ends );
+
+                for ( std::size_t b = 1; b < sorter_type::buckets; ++b )
+                {
+                    if ( ends[b] - ends[b - 1] > 1 )
+                        parts.push_back( task{ ends[b - 1], ends[b] - ends[b - 1], sorter_type::is_exact( b ) ? current.depth + 1 : current.depth } );
+                }
+
+                if ( parts.size() == 1 && parts[0].depth == current.depth )
+                {
+                    parts.clear();
+                    sorter.sort( current.lo, current.n, current.depth );
+                }
+                std::sort( parts.begin(), parts.end() );
+            }
+            else
+            {
+                sorter.sort( current.lo, current.n, current.depth );
+            }
+
+            std::lock_guard<std::mutex> lock( mutex );
+
+            tasks.insert( tasks.end(), parts.begin(), parts.end() );
+            std::sort( tasks.begin(), tasks.end() );
+            --busy;
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for ( unsigned i = 1; i < thread_count; ++i )
+        threads.emplace_back( worker );
+
+    worker();
+
+    for ( std::thread & thread : threads )
+        thread.join();
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+} // namespace detail
+
+// Sort a range of string_views or strings in place into the order of operator<:
+
+template< typename RandomIt >
+void sort_strings( RandomIt first, RandomIt last )
+{
+    detail::string_sorter<RandomIt>( first ).sort( 0, detail::to_size_t( last - first ), 0 );
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// Same, using thread_count threads for ranges of a million strings or more:
+
+template< typename RandomIt >
+void sort_strings_parallel( RandomIt first, RandomIt last, unsigned thread_count = std::thread::hardware_concurrency() )
+{
+    std::size_t const n = detail::to_size_t( last - first );
+
+    if ( thread_count < 2 || n < ( std::size_t( 1 ) << 20 ) )
+    {
+        sort_strings( first, last );
+    }
+    else
+    {
+        detail::sort_strings_parallel( first, n, thread_count );
+    }
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+} // namespace string
+
+//
+// Counting:
+//
+
+namespace string {
+
+// Count of each distinct string, as views into the counted strings, which must outlive the table. Entries are in
+// order of first occurrence and are found via an open-addressing table of 32-bit hash and entry index, probed
+// linearly:
+
+template< typename CharT >
+class basic_frequency_table
+{
+public:
+    typedef std17::basic_string_view<CharT>                    key_type;
+    typedef std::pair<key_type, std::size_t>                   value_type;
+    typedef std::size_t                                        size_type;
+    typedef typename std::vector<value_type>::const_iterator   const_iterator;
+    typedef const_iterator                                     iterator;
+
+    basic_frequency_table()
+        : entries_()
+        , slots_()
+    {}
+
+    void add( key_type text, size_type count = 1 )
+    {
+        if ( ( entries_.size() + 1 ) * 4 > slots_.size() * 3 )
+            rehash( (std::max)( slots_.size() * 2, size_type( 16 ) ) );
+
+        std::uint32_t const h = hash32( text );
+        std::size_t i = h & mask();
+
+        for ( ; slots_[i].index != 0; i = ( i + 1 ) & mask() )
+        {
+            if ( slots_[i].hash == h && entries_[ slots_[i].index - 1 ].first == text )
+            {
+                entries_[ slots_[i].index - 1 ].second += count;
+                return;
+            }
+        }
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( entries_.size() < max_size() );
+#else
+        if ( entries_.size() >= max_size() )
+        {
+            throw std::length_error("frequency_table: more than 4G - 1 distinct strings");
+        }
+#endif
+        entries_.push_back( value_type( text, count ) );
+        slots_[i].hash  = h;
+        slots_[i].index = static_cast<std::uint32_t>( entries_.size() );
+    }
+
+    // add the strings of a range, such as from split() or split_view():
+
+    template< typename Range >
+    typename std::enable_if< ! std::is_convertible<Range const &, key_type>::value >::type
+    add( Range const & texts )
+    {
+        for ( auto pos = texts.begin(); pos != texts.end(); ++pos )
+            add( detail::as_view( *pos ) );
+    }
+
+    // add the counts of other, its new strings after those of this table:
+
+    void merge( basic_frequency_table const & other )
+    {
+        for ( value_type const & entry : other.entries_ )
+            add( entry.first, entry.second );
+    }
+
+    string_nodiscard size_type count( key_type text ) const
+    {
+        if ( slots_.empty() )
+            return 0;
+
+        std::uint32_t const h = hash32( text );
+
+        for ( std::size_t i = h & mask(); slots_[i].index != 0; i = ( i + 1 ) & mask() )
+        {
+            if ( slots_[i].hash == h && entries_[ slots_[i].index - 1 ].first == text )
+                return entries_[ slots_[i].index - 1 ].second;
+        }
+        return 0;
+    }
+
+    string_nodiscard size_type size()  const string_noexcept { return entries_.size(); }
+    string_nodiscard bool      empty() const string_noexcept { return entries_.empty(); }
+
+    string_nodiscard const_iterator begin() const { return entries_.begin(); }
+    string_nodiscard const_iterator end()   const { return entries_.end(); }
+
+    void reserve( size_type n )
+    {
+        entries_.reserve( n );
+
+        size_type slots = 16;
+        while ( slots * 3 < n * 4 )
+            slots *= 2;
+
+        if ( slots > slots_.size() )
+            rehash( slots );
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        slots_.clear();
+    }
+
+    static string_constexpr size_type max_size() string_noexcept { return 0xfffffffeu; }
+
+private:
+    struct slot
+    {
+        std::uint32_t hash;
+        std::uint32_t index;    // index + 1, 0 if empty
+    };
+
+    static std::uint32_t hash32( key_type text ) string_noexcept
+    {
+        return static_cast<std::uint32_t>( detail::hash( text, 0 ) );
+    }
+
+    std::size_t mask() const string_noexcept
+    {
+        return slots_.size() - 1;
+    }
+
+    void rehash( size_type size )
+    {
+        slot const empty = { 0, 0 };
+        std::vector<slot> slots( size, empty );
+
+        for ( std::size_t k = 0; k < slots_.size(); ++k )
+        {
+            if ( slots_[k].index == 0 )
+                continue;
+
+            std::size_t i = slots_[k].hash & ( size - 1 );
+
+            while ( slots[i].index != 0 )
+                i = ( i + 1 ) & ( size - 1 );
+
+            slots[i] = slots_[k];
+        }
+        slots_.swap( slots );
+    }
+
+    std::vector<value_type> entries_;   // in order of first occurrence
+    std::vector<slot>       slots_;
+};
+
+typedef basic_frequency_table<char> frequency_table;
+
+namespace detail {
+
+// Character type of the string_views of the elements of a range:
+
+template< typename Range >
+struct range_char
+{
+    typedef typename decltype( as_view( *std::declval<Range const &>().begin() ) )::value_type type;
+};
+
+// Number of elements of a range, also of one with a sentinel as end, like split_view():
+
+template< typename Range >
+std::size_t range_size( Range const & texts )
+{
+    std::size_t n = 0;
+
+    for ( auto pos = texts.begin(); pos != texts.end(); ++pos )
+        ++n;
+
+    return n;
+}
+
+// Count in chunks that exec(count, task) processes via task(i), maybe concurrently, then merge the tables pairwise,
+// earlier chunk first, so that the order of first occurrence is kept:
+
+template< typename Range, typename Executor >
+string_nodiscard basic_frequency_table< typename range_char<Range>::type >
+count_frequencies_chunked( Range const & texts, std::size_t nchunks, Executor exec )
+{
+    typedef basic_frequency_table< typename range_char<Range>::type > table_type;
+
+    std::size_t const n = range_size( texts );
+
+    if ( nchunks < 2 || n < nchunks )
+    {
+        table_type result;
+        result.add( texts );
+        return result;
+    }
+
+    // first element of each chunk, the last chunk taking the remainder:
+
+    std::size_t const size = n / nchunks;
+    std::vector< decltype( texts.begin() ) > starts;
+
+    auto pos = texts.begin();
+    for ( std::size_t i = 0; i < n; ++i, ++pos )
+    {
+        if ( i % size == 0 && starts.size() < nchunks )
+            starts.push_back( pos );
+    }
+
+    std::vector<table_type> parts( nchunks );
+
+    exec( nchunks, [&]( std::size_t i )
+    {
+        auto chunk = starts[i];
+
+        for ( std::size_t k = i + 1 == nchunks ? n - size * i : size; k != 0; --k, ++chunk )
+            parts[i].add( as_view( *chunk ) );
+    });
+
+    for ( std::size_t step = 1; step < nchunks; step *= 2 )
+    {
+        exec( ( nchunks - step + 2 * step - 1 ) / ( 2 * step ), [&]( std::size_t k )
+        {
+            parts[ 2 * step * k ].merge( parts[ 2 * step * k + step ] );
+        });
+    }
+
+    return std::move( parts[0] );
+}
+
+} // namespace detail
+
+// Distinct strings of a range, such as from split(), in order of first occurrence:
+
+template< typename Range >
+string_nodiscard std::vector< std17::basic_string_view< typename detail::range_char<Range>::type > >
+distinct( Range const & texts )
+{
+    basic_frequency_table< typename detail::range_char<Range>::type > table;
+    table.add( texts );
+
+    std::vector< std17::basic_string_view< typename detail::range_char<Range>::type > > result;
+    result.reserve( table.size() );
+
+    for ( auto const & entry : table )
+        result.push_back( entry.first );
+
+    return result;
+}
+
+// Count of each distinct string of a range:
+
+template< typename Range >
+string_nodiscard basic_frequency_table< typename detail::range_char<Range>::type >
+count_frequencies( Range const & texts )
+{
+    basic_frequency_table< typename detail::range_char<Range>::type > result;
+    result.add( texts );
+    return result;
+}
+
+// Same, counted in chunks via exec(count, task), which calls task(i) for i in [0, count), maybe concurrently:
+
+template< typename Range, typename Executor >
+string_nodiscard basic_frequency_table< typename detail::range_char<Range>::type >
+count_frequencies_parallel( Range const & texts, std::size_t nchunks, Executor exec )
+{
+    return detail::count_frequencies_chunked( texts, nchunks, exec );
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// Same, on std::thread-s, at least 16k strings per thread:
+
+template< typename Range >
+string_nodiscard basic_frequency_table< typename detail::range_char<Range>::type >
+count_frequencies_parallel( Range const & texts )
+{
+    std::size_t const hw = (std::max)( std::size_t( std::thread::hardware_concurrency() ), std::size_t( 1 ) );
+    std::size_t const n  = detail::range_size( texts );
+
+    return detail::count_frequencies_chunked( texts, (std::min)( hw, n / 16384 ), detail::thread_executor() );
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+} // namespace string
+
+//
+// Sorted string dictionary:
+//
+
+namespace string {
+namespace detail {
+
+// Unsigned integer in units of 7 bits, least significant first, with the high bit of a unit set if more follow:
+
+template< typename CharT >
+void put_varint( std::basic_string<CharT> & text, std::size_t value )
+{
+    for ( ; value >= 0x80; value >>= 7 )
+        text += static_cast<CharT>( ( value & 0x7f ) | 0x80 );
+
+    text += static_cast<CharT>( value );
+}
+
+template< typename CharT >
+std::size_t get_varint( CharT const * & p ) string_noexcept
+{
+    std::size_t value = 0;
+
+    for ( int shift = 0; ; shift += 7 )
+    {
+        std::size_t const unit = static_cast<typename std::make_unsigned<CharT>::type>( *p++ );
+
+        value |= ( unit & 0x7f ) << shift;
+
+        if ( ( unit & 0x80 ) == 0 )
+            return value;
+    }
+}
+
+} // namespace detail
+
+// Sorted unique strings, front coded: in blocks of block_size strings, the first is stored as length and characters,
+// the others as the length of the prefix they share with the previous string, the length of the rest and the
+// characters of the rest. The start of each block is kept, so that a key is found by binary search over the first
+// strings of the blocks, which are compared in place, and decoding at most one block. Strings are decoded by index
+// or visited in order via const_iterator, which gives a view that is valid until it is incremented:
+
+template< typename CharT >
+class basic_sorted_string_dict
+{
+public:
+    typedef std17::basic_string_view<CharT> key_type;
+    typedef std::basic_string<CharT>        value_type;
+    typedef std::size_t                     size_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef key_type                value_type;
+        typedef std::ptrdiff_t          difference_type;
+        typedef key_type const *        pointer;
+        typedef key_type                reference;
+
+        const_iterator()
+            : dict_( string_nullptr ), index_( 0 ), pos_( 0 ), text_()
+        {}
+
+        string_nodiscard key_type  operator*() const { return key_type( text_.data(), text_.size() ); }
+        string_nodiscard size_type index()     const string_noexcept { return index_; }
+
+        const_iterator & operator++()
+        {
+            ++index_;
+            decode();
+            return *this;
+        }
+
+        const_iterator operator++( int )
+        {
+            const_iterator result( *this );
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==( const_iterator const & lhs, const_iterator const & rhs ) string_noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=( const_iterator const & lhs, const_iterator const & rhs ) string_noexcept
+        {
+            return !( lhs == rhs );
+        }
+
+    private:
+        friend class basic_sorted_string_dict;
+
+        const_iterator( basic_sorted_string_dict const * dict, size_type index )
+            : dict_( dict ), index_( index ), pos_( 0 ), text_()
+        {
+            if ( index_ >= dict_->size() )
+                return;
+
+            size_type const first = index_ - index_ % dict_->block_size_;
+
+            pos_   = dict_->restarts_[ first / dict_->block_size_ ];
+            index_ = first;
+            decode();
+
+            while ( index_ != index )
+                ++*this;
+        }
+
+        void decode()
+        {
+            if ( index_ >= dict_->size() )
+                return;
+
+            CharT const * p = dict_->data_.data() + pos_;
+
+            size_type const shared = index_ % dict_->block_size_ == 0 ? 0 : detail::get_varint( p );
+            size_type const rest   = detail::get_varint( p );
+
+            text_.resize( shared );
+            text_.append( p, rest );
+            pos_ = detail::to_size_t( p + rest - dict_->data_.data() );
+        }
+
+        basic_sorted_string_dict const * dict_;
+        size_type                        index_;
+        size_type                        pos_;      // of next string in data_
+        std::basic_string<CharT>         text_;
+    };
+
+    typedef const_iterator iterator;
+
+    explicit basic_sorted_string_dict( size_type block_size = 16 )
+        : data_()
+        , restarts_()
+        , last_()
+        , size_( 0 )
+        , block_size_( (std::max)( block_size, size_type( 1 ) ) )
+    {}
+
+    // the distinct strings of a range, such as from split(), in any order:
+
+    template< typename Range, typename = typename std::enable_if< ! std::is_integral<Range>::value >::type >
+    explicit basic_sorted_string_dict( Range const & texts, size_type block_size = 16 )
+        : data_()
+        , restarts_()
+        , last_()
+        , size_( 0 )
+        , block_size_( (std::max)( block_size, size_type( 1 ) ) )
+    {
+        std::vector<key_type> keys;
+
+        for ( auto pos = texts.begin(); pos != texts.end(); ++pos )
+            keys.push_back( detail::as_view( *pos ) );
+
+        sort_strings( keys.begin(), keys.end() );
+        keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+        for ( key_type const & key : keys )
+            push_back( key );
+
+        shrink_to_fit();
+    }
+
+    // append a string greater than the last one:
+
+    void push_back( key_type key )
+    {
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( size_ == 0 || key_type( last_.data(), last_.size() ) < key );
+#else
+        if ( size_ != 0 && !( key_type( last_.data(), last_.size() ) < key ) )
+        {
+            throw std::invalid_argument("sorted_string_dict: push_back() of key not greater than the last one");
+        }
+#endif
+        size_type shared = 0;
+
+        if ( size_ % block_size_ == 0 )
+        {
+            restarts_.push_back( data_.size() );
+        }
+        else
+        {
+            size_type const n = (std::min)( last_.size(), key.size() );
+
+            while ( shared < n && last_[shared] == key.data()[shared] )
+                ++shared;
+
+            detail::put_varint( data_, shared );
+        }
+
+        detail::put_varint( data_, key.size() - shared );
+        data_.append( key.data() + shared, key.size() - shared );
+
+        last_.assign( key.data(), key.size() );
+        ++size_;
+    }
+
+    string_nodiscard value_type operator[]( size_type index ) const
+    {
+        assert( index < size() );
+
+        return value_type( *const_iterator( this, index ) );
+    }
+
+    // index of the first string not less than key, size() if none:
+
+    string_nodiscard size_type lower_bound( key_type key ) const
+    {
+        return partition_point( [key]( key_type text ) { return text < key; } ).index();
+    }
+
+    // index of key, or npos:
+
+    string_nodiscard size_type find( key_type key ) const
+    {
+        const_iterator const pos = partition_point( [key]( key_type text ) { return text < key; } );
+
+        return pos != end() && *pos == key ? pos.index() : npos;
+    }
+
+    string_nodiscard bool contains( key_type key ) const
+    {
+        return find( key ) != npos;
+    }
+
+    // the strings that start with prefix:
+
+    string_nodiscard std::pair<const_iterator, const_iterator> prefix_range( key_type prefix ) const
+    {
+        const_iterator const first = partition_point( [prefix]( key_type text ) { return text < prefix; } );
+
+        if ( first == end() || ! starts_with( *first, prefix ) )
+            return std::make_pair( first, first );
+
+        return std::make_pair( first, partition_point( [prefix]( key_type text )
+        {
+            return text < prefix || text.substr( 0, prefix.size() ) == prefix;
+        }));
+    }
+
+    string_nodiscard const_iterator begin() const { return const_iterator( this, 0 ); }
+    string_nodiscard const_iterator end()   const { return const_iterator( this, size_ ); }
+
+    string_nodiscard size_type size()  const string_noexcept { return size_; }
+    string_nodiscard bool      empty() const string_noexcept { return size_ == 0; }
+
+    // memory allocated, in bytes:
+
+    string_nodiscard size_type bytes() const string_noexcept
+    {
+        return data_.capacity() * sizeof(CharT) + restarts_.capacity() * sizeof(size_type) + last_.capacity() * sizeof(CharT);
+    }
+
+    void shrink_to_fit()
+    {
+        data_.shrink_to_fit();
+        restarts_.shrink_to_fit();
+    }
+
+    void clear()
+    {
+        data_.clear();
+        restarts_.clear();
+        last_.clear();
+        size_ = 0;
+    }
+
+private:
+    static bool starts_with( key_type text, key_type prefix )
+    {
+        return text.substr( 0, (std::min)( text.size(), prefix.size() ) ) == prefix;
+    }
+
+    key_type head( size_type block ) const
+    {
+        CharT const * p = data_.data() + restarts_[block];
+        size_type const length = detail::get_varint( p );
+
+        return key_type( p, length );
+    }
+
+    // first string for which pred is false, pred being true for a leading part of the strings:
+
+    template< typename Pred >
+    const_iterator partition_point( Pred pred ) const
+    {
+        size_type lo = 0;
+        size_type hi = restarts_.size();
+
+        while ( lo < hi )
+        {
+            size_type const mid = lo + ( hi - lo ) / 2;
+
+            if ( pred( head( mid ) ) )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if ( lo == 0 )
+            return begin();
+
+        const_iterator pos( this, ( lo - 1 ) * block_size_ );
+        size_type const last = (std::min)( lo * block_size_, size_ );
+
+        for ( ++pos; pos.index() != last && pred( *pos ); ++pos )
+        {}
+
+        return pos;
+    }
+
+    value_type             data_;
+    std::vector<size_type> restarts_;   // position of first string of each block in data_
+    value_type             last_;
+    size_type              size_;
+    size_type              block_size_;
+};
+
+typedef basic_sorted_string_dict<char> sorted_string_dict;
+
+} // namespace string
+
+//
+// String map:
+//
+
+namespace string {
+
+// Map of string to V with the keys in a chunked arena and the entries in a vector, in order of insertion. Entries
+// are found via an open-addressing table in the style of Swiss tables: a control byte per slot, holding 7 bits of
+// the hash of the key of a full slot or marking the slot empty or deleted, and a 32-bit entry index per slot.
+// Probing is by groups of eight slots, whose control bytes are matched against the hash fragment at once as a
+// 64-bit word, so that a key is compared only on a match. Lookup takes any string_view, string or C-string.
+// Entries are std::pair<key_type const, V>, so that a key cannot be changed via an iterator. Erasing replaces the
+// erased entry by the last one, which requires V to be nothrow move constructible; the key of the erased entry
+// stays in the arena until clear():
+
+template< typename CharT, typename V >
+class basic_string_map
+{
+public:
+    typedef std17::basic_string_view<CharT>                     key_type;
+    typedef V                                                   mapped_type;
+    typedef std::pair<key_type const, V>                        value_type;
+    typedef std::size_t                                         size_type;
+    typedef typename std::vector<value_type>::iterator          iterator;
+    typedef typename std::vector<value_type>::const_iterator    const_iterator;
+
+    // chunk size in characters:
+
+    explicit basic_string_map( size_type chunk_size = 65536 / sizeof(CharT) )
+        : arena_( chunk_size )
+        , entries_()
+        , ctrl_()
+        , index_()
+        , tombstones_( 0 )
+    {}
+
+    // insert key with value constructed from args if key is not present:
+
+    template< typename... Args >
+    std::pair<iterator, bool> try_emplace( key_type key, Args &&... args )
+    {
+        std::pair<size_type, bool> const result = emplace_index( key, std::forward<Args>( args )... );
+
+        return std::make_pair( at_entry( result.first ), result.second );
+    }
+
+    std::pair<iterator, bool> insert( value_type const & value )
+    {
+        return try_emplace( value.first, value.second );
+    }
+
+    V & operator[]( key_type key )
+    {
+        return entries_[ emplace_index( key ).first ].second;
+    }
+
+    V & at( key_type key )
+    {
+        return const_cast<V &>( static_cast<basic_string_map const &>( *this ).at( key ) );
+    }
+
+    V const & at( key_type key ) const
+    {
+        size_type const slot = find_slot( key, detail::hash( key, 0 ) );
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( slot != npos );
+#else
+        if ( slot == npos )
+        {
+            throw std::out_of_range("string_map::at(): key not present");
+        }
+#endif
+        return entries_[ index_[slot] ].second;
+    }
+
+    string_nodiscard iterator find( key_type key )
+    {
+        size_type const slot = find_slot( key, detail::hash( key, 0 ) );
+
+        return slot != npos ? at_entry( index_[slot] ) : entries_.end();
+    }
+
+    string_nodiscard const_iterator find( key_type key ) const
+    {
+        return const_cast<basic_string_map &>( *this ).find( key );
+    }
+
+    string_nodiscard size_type count( key_type key ) const
+    {
+        return find_slot( key, detail::hash( key, 0 ) ) != npos ? 1 : 0;
+    }
+
+    string_nodiscard bool contains( key_type key ) const
+    {
+        return count( key ) != 0;
+    }
+
+    size_type erase( key_type key )
+    {
+        size_type const slot = find_slot( key, detail::hash( key, 0 ) );
+
+        if ( slot == npos )
+            return 0;
+
+        size_type const i    = index_[slot];
+        size_type const last = entries_.size() - 1;
+
+        set_ctrl( slot, ctrl_deleted() );
+        ++tombstones_;
+
+        if ( i != last )
+        {
+            index_[ find_slot( entries_[last].first, detail::hash( entries_[last].first, 0 ) ) ] = static_cast<std::uint32_t>( i );
+            replace( i, last );
+        }
+
+        entries_.pop_back();
+        return 1;
+    }
+
+    string_nodiscard iterator       begin()       { return entries_.begin(); }
+    string_nodiscard iterator       end()         { return entries_.end(); }
+    string_nodiscard const_iterator begin() const { return entries_.begin(); }
+    string_nodiscard const_iterator end()   const { return entries_.end(); }
+
+    string_nodiscard size_type size()  const string_noexcept { return entries_.size(); }
+    string_nodiscard bool      empty() const string_noexcept { return entries_.empty(); }
+
+    void reserve( size_type n )
+    {
+        entries_.reserve( n );
+
+        size_type slots = group_size;
+        while ( n * 8 > slots * 7 )
+            slots *= 2;
+
+        if ( slots > capacity() )
+            rehash( slots );
+    }
+
+    void clear()
+    {
+        arena_.clear();
+        entries_.clear();
+        ctrl_.clear();
+        index_.clear();
+        tombstones_ = 0;
+    }
+
+    static string_constexpr size_type max_size() string_noexcept { return 0xfffffffeu; }
+
+private:
+    enum { group_size = 8 };
+
+    // index of entry of key, with value constructed from args if key is not present, and whether it was inserted:
+
+    template< typename... Args >
+    std::pair<size_type, bool> emplace_index( key_type key, Args &&... args )
+    {
+        std::uint64_t const h = detail::hash( key, 0 );
+        size_type slot = find_slot( key, h );
+
+        if ( slot != npos )
+            return std::make_pair( size_type( index_[slot] ), false );
+
+#if string_CONFIG_NO_EXCEPTIONS
+        assert( entries_.size() < max_size() );
+#else
+        if ( entries_.size() >= max_size() )
+        {
+            throw std::length_error("string_map: more than 4G - 1 entries");
+        }
+#endif
+        if ( ( entries_.size() + tombstones_ + 1 ) * 8 > capacity() * 7 )
+            grow();
+
+        slot = free_slot( h );
+
+        entries_.emplace_back(
+            std::piecewise_construct
+            , std::forward_as_tuple( arena_.store( key ), key.size() )
+            , std::forward_as_tuple( std::forward<Args>( args )... ) );
+
+        if ( ctrl_[slot] == ctrl_deleted() )
+            --tombstones_;
+
+        set_ctrl( slot, fragment( h ) );
+        index_[slot] = static_cast<std::uint32_t>( entries_.size() - 1 );
+
+        return std::make_pair( entries_.size() - 1, true );
+    }
+
+    static string_constexpr char ctrl_empty()   string_noexcept { return static_cast<char>( 0x80 ); }
+    static string_constexpr char ctrl_deleted() string_noexcept { return static_cast<char>( 0xfe ); }
+
+    static char fragment( std::uint64_t h ) string_noexcept
+    {
+        return static_cast<char>( h & 0x7f );
+    }
+
+    // control bytes of a group that are empty, and that are empty or deleted, as high bits:
+
+    static std::uint64_t empty_bytes( std::uint64_t group ) string_noexcept
+    {
+        return group & ~( group << 6 ) & 0x8080808080808080u;
+    }
+
+    static std::uint64_t free_bytes( std::uint64_t group ) string_noexcept
+    {
+        return group & 0x8080808080808080u;
+    }
+
+    size_type capacity() const string_noexcept
+    {
+        return index_.size();
+    }
+
+    iterator at_entry( size_type i )
+    {
+        return entries_.begin() + static_cast<std::ptrdiff_t>( i );
+    }
+
+    // entry i destroyed and constructed anew from entry last, as its key is const:
+
+    void replace( size_type i, size_type last )
+    {
+        static_assert( std::is_nothrow_move_constructible<V>::value, "string_map: erase() requires V to be nothrow move constructible" );
+
+        value_type * const entry = std::addressof( entries_[i] );
+
+        entry->~value_type();
+        ::new( static_cast<void *>( entry ) ) value_type( std::move( entries_[last] ) );
+    }
+
+    // control bytes of the first group are repeated after the last slot, so that a group can start at any slot:
+
+    void set_ctrl( size_type slot, char value )
+    {
+        ctrl_[slot] = value;
+
+        if ( slot < group_size )
+            ctrl_[ capacity() + slot ] = value;
+    }
+
+    // groups are probed at triangular offsets, which visits all of them as the capacity is a power of two:
+
+    size_type find_slot( key_type key, std::uint64_t h ) const
+    {
+        if ( index_.empty() )
+            return npos;
+
+        size_type const      mask  = capacity() - 1;
+        std::uint64_t const  match = detail::broadcast64( fragment( h ) );
+
+        for ( size_type pos = ( h >> 7 ) & mask, step = group_size; ; pos = ( pos + step ) & mask, step += group_size )
+        {
+            std::uint64_t const group = detail::load_le64( ctrl_.data() + pos );
+
+            for ( std::uint64_t bits = detail::zero_bytes64( group ^ match ); bits != 0; bits &= bits - 1 )
+            {
+                size_type const slot = ( pos + detail::to_size_t( detail::ctz64( bits ) ) / 8 ) & mask;
+
+                if ( entries_[ index_[slot] ].first == key )
+                    return slot;
+            }
+
+            if ( empty_bytes( group ) != 0 )
+                return npos;
+        }
+    }
+
+    size_type free_slot( std::uint64_t h ) const
+    {
+        size_type const mask = capacity() - 1;
+
+        for ( size_type pos = ( h >> 7 ) & mask, step = group_size; ; pos = ( pos + step ) & mask, step += group_size )
+        {
+            std::uint64_t const bits = free_bytes( detail::load_le64( ctrl_.data() + pos ) );
+
+            if ( bits != 0 )
+                return ( pos + detail::to_size_t( detail::ctz64( bits ) ) / 8 ) & mask;
+        }
+    }
+
+    // at most 7/16 full after growing, which also removes deleted slots:
+
+    void grow()
+    {
+        size_type slots = group_size;
+        while ( ( entries_.size() + 1 ) * 16 > slots * 7 )
+            slots *= 2;
+
+        rehash( (std::max)( slots, capacity() ) );
+    }
+
+    void rehash( size_type slots )
+    {
+        ctrl_.assign( slots + group_size, ctrl_empty() );
+        index_.assign( slots, 0 );
+        tombstones_ = 0;
+
+        for ( size_type i = 0; i < entries_.size(); ++i )
+        {
+            std::uint64_t const h    = detail::hash( entries_[i].first, 0 );
+            size_type const     slot = free_slot( h );
+
+            set_ctrl( slot, fragment( h ) );
+            index_[slot] = static_cast<std::uint32_t>( i );
+        }
+    }
+
+    detail::char_arena<CharT>   arena_;
+    std::vector<value_type>     entries_;       // in order of insertion
+    std::vector<char>           ctrl_;          // per slot, and repeated first group
+    std::vector<std::uint32_t>  index_;         // entry per slot
+    size_type                   tombstones_;    // deleted slots
+};
+
+template< typename V >
+using string_map = basic_string_map<char, V>;
+
+} // namespace string
+
+//
+// Comparision:
+//
+
+// defined in namespace nonstd
+
+#define string_MK_COMPARE( CharT )                  \
+    string_nodiscard inline string_constexpr14 int  \
+    compare( std17::basic_string_view<CharT> lhs, std17::basic_string_view<CharT> rhs ) string_noexcept \
+    {                                               \
+        return lhs.compare( rhs );                  \
+    }
+
+// defined in namespace nonstd::string::std17
+
+#define string_MK_COMPARE_EQ( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator==( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
+    {                                               \
+        return compare( lhs, rhs ) == 0;            \
+    }
+
+#define string_MK_COMPARE_NE( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator!=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
+    {                                               \
+        return compare( lhs, rhs ) != 0;            \
+    }
+
+#define string_MK_COMPARE_LT( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator<( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )   \
+    {                                               \
+        return compare( lhs, rhs ) < 0;             \
+    }
+
+#define string_MK_COMPARE_LE( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator<=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
+    {                                               \
+        return compare( lhs, rhs ) <= 0;            \
+    }
+
+#define string_MK_COMPARE_GE( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator>=( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )  \
+    {                                               \
+        return compare( lhs, rhs ) >= 0;            \
+    }
+
+#define string_MK_COMPARE_GT( CharT )               \
+    string_nodiscard inline string_constexpr14 bool \
+    operator>( basic_string_view<CharT> lhs, basic_string_view<CharT> rhs )   \
+    {                                               \
         return compare( lhs, rhs ) > 0;             \
     }
 
@@ -1738,6 +6949,7 @@ using detail::to_string;
 string_MK_IS_EMPTY           ( char )
 string_MK_LENGTH             ( char )
 string_MK_SIZE               ( char )
+string_MK_COUNT_LINES        ( char )
 string_MK_FIND_FIRST         ( char )
 string_MK_FIND_FIRST_CHAR    ( char )
 string_MK_FIND_LAST          ( char )
@@ -1746,6 +6958,8 @@ string_MK_FIND_FIRST_OF      ( char )
 string_MK_FIND_LAST_OF       ( char )
 string_MK_FIND_FIRST_NOT_OF  ( char )
 string_MK_FIND_LAST_NOT_OF   ( char )
+string_MK_FIND_ALL_OF        ( char )
+string_MK_STATIC_SET_FIND    ( char )
 string_MK_APPEND             ( char )
 string_MK_CONTAINS           ( char )      // includes char search type
 string_MK_CONTAINS_ALL_OF    ( char )
@@ -1773,6 +6987,7 @@ string_MK_REPLACE_LAST       ( char )
 string_MK_STRIP_LEFT         ( char )
 string_MK_STRIP_RIGHT        ( char )
 string_MK_STRIP              ( char )
+string_MK_STATIC_SET_STRIP   ( char )
 string_MK_SUBSTRING          ( char )
 string_MK_TO_CASE_CHAR       ( char, lowercase )
 string_MK_TO_CASE_CHAR       ( char, uppercase )
@@ -1781,8 +6996,31 @@ string_MK_TO_CASE_STRING     ( char, uppercase )
 string_MK_CAPITALIZE         ( char )
 string_MK_JOIN               ( char )
 string_MK_SPLIT              ( char )
+string_MK_STATIC_SET_SPLIT   ( char )
+string_MK_SPLIT_VIEW         ( char )
+string_MK_SPLIT_OPTIONS      ( char )
+string_MK_SPLIT_INTO         ( char )
+string_MK_SPLIT_N            ( char )
+string_MK_SPLIT_BULK         ( char )
+string_MK_SPLIT_OFFSETS      ( char )
+string_MK_SPLIT_PARALLEL     ( char )
+string_MK_SPLIT_QUOTED       ( char )
+string_MK_RSPLIT             ( char )
+string_MK_RSPLIT_VIEW        ( char )
 string_MK_SPLIT_LEFT         ( char )
 string_MK_SPLIT_RIGHT        ( char )
+string_MK_SPLIT_ON           ( char )
+string_MK_SPLIT_ON_VIEW      ( char )
+string_MK_SPLIT_LEFT_ON      ( char )
+string_MK_SPLIT_RIGHT_ON     ( char )
+string_MK_SPLIT_PAIRS        ( char )
+string_MK_SPLIT_PAIRS_VIEW   ( char )
+string_MK_LINES              ( char )
+string_MK_SCAN               ( char )
+string_MK_SCAN_VALUES        ( char )
+string_MK_HASH               ( char )
+string_MK_MAKE_STRING_SWITCH ( char )
+string_MK_PREFIX_SET         ( char )
 
 string_MK_COMPARE            ( char )
 
@@ -1806,6 +7044,7 @@ string_MK_COMPARE_GT         ( char )
 string_MK_IS_EMPTY           ( wchar_t )
 string_MK_LENGTH             ( wchar_t )
 string_MK_SIZE               ( wchar_t )
+string_MK_COUNT_LINES        ( wchar_t )
 string_MK_FIND_FIRST         ( wchar_t )
 string_MK_FIND_FIRST_CHAR    ( wchar_t )
 string_MK_FIND_LAST          ( wchar_t )
@@ -1814,6 +7053,8 @@ string_MK_FIND_FIRST_OF      ( wchar_t )
 string_MK_FIND_LAST_OF       ( wchar_t )
 string_MK_FIND_FIRST_NOT_OF  ( wchar_t )
 string_MK_FIND_LAST_NOT_OF   ( wchar_t )
+string_MK_FIND_ALL_OF        ( wchar_t )
+string_MK_STATIC_SET_FIND    ( wchar_t )
 string_MK_APPEND             ( wchar_t )
 string_MK_CONTAINS           ( wchar_t )      // includes wchar_t search type
 string_MK_CONTAINS_ALL_OF    ( wchar_t )
@@ -1841,6 +7082,7 @@ string_MK_REPLACE_LAST       ( wchar_t )
 string_MK_STRIP_LEFT         ( wchar_t )
 string_MK_STRIP_RIGHT        ( wchar_t )
 string_MK_STRIP              ( wchar_t )
+string_MK_STATIC_SET_STRIP   ( wchar_t )
 string_MK_SUBSTRING          ( wchar_t )
 string_MK_TO_CASE_CHAR       ( wchar_t, lowercase )
 string_MK_TO_CASE_CHAR       ( wchar_t, uppercase )
@@ -1849,8 +7091,31 @@ string_MK_TO_CASE_STRING     ( wchar_t, uppercase )
 string_MK_CAPITALIZE         ( wchar_t )
 string_MK_JOIN               ( wchar_t )
 string_MK_SPLIT              ( wchar_t )
+string_MK_STATIC_SET_SPLIT   ( wchar_t )
+string_MK_SPLIT_VIEW         ( wchar_t )
+string_MK_SPLIT_OPTIONS      ( wchar_t )
+string_MK_SPLIT_INTO         ( wchar_t )
+string_MK_SPLIT_N            ( wchar_t )
+string_MK_SPLIT_BULK         ( wchar_t )
+string_MK_SPLIT_OFFSETS      ( wchar_t )
+string_MK_SPLIT_PARALLEL     ( wchar_t )
+string_MK_SPLIT_QUOTED       ( wchar_t )
+string_MK_RSPLIT             ( wchar_t )
+string_MK_RSPLIT_VIEW        ( wchar_t )
 string_MK_SPLIT_LEFT         ( wchar_t )
 string_MK_SPLIT_RIGHT        ( wchar_t )
+string_MK_SPLIT_ON           ( wchar_t )
+string_MK_SPLIT_ON_VIEW      ( wchar_t )
+string_MK_SPLIT_LEFT_ON      ( wchar_t )
+string_MK_SPLIT_RIGHT_ON     ( wchar_t )
+string_MK_SPLIT_PAIRS        ( wchar_t )
+string_MK_SPLIT_PAIRS_VIEW   ( wchar_t )
+string_MK_LINES              ( wchar_t )
+string_MK_SCAN               ( wchar_t )
+string_MK_SCAN_VALUES        ( wchar_t )
+string_MK_HASH               ( wchar_t )
+string_MK_MAKE_STRING_SWITCH ( wchar_t )
+string_MK_PREFIX_SET         ( wchar_t )
 // ...
 string_MK_COMPARE            ( wchar_t )
 
@@ -1874,6 +7139,7 @@ string_MK_COMPARE_GT         ( wchar_t )
 string_MK_IS_EMPTY           ( char8_t )
 string_MK_LENGTH             ( char8_t )
 string_MK_SIZE               ( char8_t )
+string_MK_COUNT_LINES        ( char8_t )
 string_MK_FIND_FIRST         ( char8_t )
 string_MK_FIND_FIRST_CHAR    ( char8_t )
 string_MK_FIND_LAST          ( char8_t )
@@ -1882,6 +7148,8 @@ string_MK_FIND_FIRST_OF      ( char8_t )
 string_MK_FIND_LAST_OF       ( char8_t )
 string_MK_FIND_FIRST_NOT_OF  ( char8_t )
 string_MK_FIND_LAST_NOT_OF   ( char8_t )
+string_MK_FIND_ALL_OF        ( char8_t )
+string_MK_STATIC_SET_FIND    ( char8_t )
 string_MK_APPEND             ( char8_t )
 string_MK_CONTAINS           ( char8_t )      // includes char search type
 string_MK_CONTAINS_ALL_OF    ( char8_t )
@@ -1909,6 +7177,7 @@ string_MK_REPLACE_LAST       ( char8_t )
 string_MK_STRIP_LEFT         ( char8_t )
 string_MK_STRIP_RIGHT        ( char8_t )
 string_MK_STRIP              ( char8_t )
+string_MK_STATIC_SET_STRIP   ( char8_t )
 string_MK_SUBSTRING          ( char8_t )
 string_MK_TO_CASE_CHAR       ( char8_t, lowercase )
 string_MK_TO_CASE_CHAR       ( char8_t, uppercase )
@@ -1917,8 +7186,31 @@ string_MK_TO_CASE_STRING     ( char8_t, uppercase )
 string_MK_CAPITALIZE         ( char8_t )
 string_MK_JOIN               ( char8_t )
 string_MK_SPLIT              ( char8_t )
+string_MK_STATIC_SET_SPLIT   ( char8_t )
+string_MK_SPLIT_VIEW         ( char8_t )
+string_MK_SPLIT_OPTIONS      ( char8_t )
+string_MK_SPLIT_INTO         ( char8_t )
+string_MK_SPLIT_N            ( char8_t )
+string_MK_SPLIT_BULK         ( char8_t )
+string_MK_SPLIT_OFFSETS      ( char8_t )
+string_MK_SPLIT_PARALLEL     ( char8_t )
+string_MK_SPLIT_QUOTED       ( char8_t )
+string_MK_RSPLIT             ( char8_t )
+string_MK_RSPLIT_VIEW        ( char8_t )
 string_MK_SPLIT_LEFT         ( char8_t )
 string_MK_SPLIT_RIGHT        ( char8_t )
+string_MK_SPLIT_ON           ( char8_t )
+string_MK_SPLIT_ON_VIEW      ( char8_t )
+string_MK_SPLIT_LEFT_ON      ( char8_t )
+string_MK_SPLIT_RIGHT_ON     ( char8_t )
+string_MK_SPLIT_PAIRS        ( char8_t )
+string_MK_SPLIT_PAIRS_VIEW   ( char8_t )
+string_MK_LINES              ( char8_t )
+string_MK_SCAN               ( char8_t )
+string_MK_SCAN_VALUES        ( char8_t )
+string_MK_HASH               ( char8_t )
+string_MK_MAKE_STRING_SWITCH ( char8_t )
+string_MK_PREFIX_SET         ( char8_t )
 // ...
 string_MK_COMPARE            ( char8_t )
 
@@ -1942,6 +7234,7 @@ string_MK_COMPARE_GT         ( char8_t )
 string_MK_IS_EMPTY           ( char16_t )
 string_MK_LENGTH             ( char16_t )
 string_MK_SIZE               ( char16_t )
+string_MK_COUNT_LINES        ( char16_t )
 string_MK_FIND_FIRST         ( char16_t )
 string_MK_FIND_FIRST_CHAR    ( char16_t )
 string_MK_FIND_LAST          ( char16_t )
@@ -1950,6 +7243,8 @@ string_MK_FIND_FIRST_OF      ( char16_t )
 string_MK_FIND_LAST_OF       ( char16_t )
 string_MK_FIND_FIRST_NOT_OF  ( char16_t )
 string_MK_FIND_LAST_NOT_OF   ( char16_t )
+string_MK_FIND_ALL_OF        ( char16_t )
+string_MK_STATIC_SET_FIND    ( char16_t )
 string_MK_APPEND             ( char16_t )
 string_MK_CONTAINS           ( char16_t )      // includes char search type
 string_MK_CONTAINS_ALL_OF    ( char16_t )
@@ -1977,6 +7272,7 @@ string_MK_REPLACE_LAST       ( char16_t )
 string_MK_STRIP_LEFT         ( char16_t )
 string_MK_STRIP_RIGHT        ( char16_t )
 string_MK_STRIP              ( char16_t )
+string_MK_STATIC_SET_STRIP   ( char16_t )
 string_MK_SUBSTRING          ( char16_t )
 string_MK_TO_CASE_CHAR       ( char16_t, lowercase )
 string_MK_TO_CASE_CHAR       ( char16_t, uppercase )
@@ -1985,8 +7281,31 @@ string_MK_TO_CASE_STRING     ( char16_t, uppercase )
 string_MK_CAPITALIZE         ( char16_t )
 string_MK_JOIN               ( char16_t )
 string_MK_SPLIT              ( char16_t )
+string_MK_STATIC_SET_SPLIT   ( char16_t )
+string_MK_SPLIT_VIEW         ( char16_t )
+string_MK_SPLIT_OPTIONS      ( char16_t )
+string_MK_SPLIT_INTO         ( char16_t )
+string_MK_SPLIT_N            ( char16_t )
+string_MK_SPLIT_BULK         ( char16_t )
+string_MK_SPLIT_OFFSETS      ( char16_t )
+string_MK_SPLIT_PARALLEL     ( char16_t )
+string_MK_SPLIT_QUOTED       ( char16_t )
+string_MK_RSPLIT             ( char16_t )
+string_MK_RSPLIT_VIEW        ( char16_t )
 string_MK_SPLIT_LEFT         ( char16_t )
 string_MK_SPLIT_RIGHT        ( char16_t )
+string_MK_SPLIT_ON           ( char16_t )
+string_MK_SPLIT_ON_VIEW      ( char16_t )
+string_MK_SPLIT_LEFT_ON      ( char16_t )
+string_MK_SPLIT_RIGHT_ON     ( char16_t )
+string_MK_SPLIT_PAIRS        ( char16_t )
+string_MK_SPLIT_PAIRS_VIEW   ( char16_t )
+string_MK_LINES              ( char16_t )
+string_MK_SCAN               ( char16_t )
+string_MK_SCAN_VALUES        ( char16_t )
+string_MK_HASH               ( char16_t )
+string_MK_MAKE_STRING_SWITCH ( char16_t )
+string_MK_PREFIX_SET         ( char16_t )
 // ...
 string_MK_COMPARE            ( char16_t )
 
@@ -2010,6 +7329,7 @@ string_MK_COMPARE_GT         ( char16_t )
 string_MK_IS_EMPTY           ( char32_t )
 string_MK_LENGTH             ( char32_t )
 string_MK_SIZE               ( char32_t )
+string_MK_COUNT_LINES        ( char32_t )
 string_MK_FIND_FIRST         ( char32_t )
 string_MK_FIND_FIRST_CHAR    ( char32_t )
 string_MK_FIND_LAST          ( char32_t )
@@ -2018,6 +7338,8 @@ string_MK_FIND_FIRST_OF      ( char32_t )
 string_MK_FIND_LAST_OF       ( char32_t )
 string_MK_FIND_FIRST_NOT_OF  ( char32_t )
 string_MK_FIND_LAST_NOT_OF   ( char32_t )
+string_MK_FIND_ALL_OF        ( char32_t )
+string_MK_STATIC_SET_FIND    ( char32_t )
 string_MK_APPEND             ( char32_t )
 string_MK_CONTAINS           ( char32_t )      // includes char search type
 string_MK_CONTAINS_ALL_OF    ( char32_t )
@@ -2045,6 +7367,7 @@ string_MK_REPLACE_LAST       ( char32_t )
 string_MK_STRIP_LEFT         ( char32_t )
 string_MK_STRIP_RIGHT        ( char32_t )
 string_MK_STRIP              ( char32_t )
+string_MK_STATIC_SET_STRIP   ( char32_t )
 string_MK_SUBSTRING          ( char32_t )
 string_MK_TO_CASE_CHAR       ( char32_t, lowercase )
 string_MK_TO_CASE_CHAR       ( char32_t, uppercase )
@@ -2053,8 +7376,31 @@ string_MK_TO_CASE_STRING     ( char32_t, uppercase )
 string_MK_CAPITALIZE         ( char32_t )
 string_MK_JOIN               ( char32_t )
 string_MK_SPLIT              ( char32_t )
+string_MK_STATIC_SET_SPLIT   ( char32_t )
+string_MK_SPLIT_VIEW         ( char32_t )
+string_MK_SPLIT_OPTIONS      ( char32_t )
+string_MK_SPLIT_INTO         ( char32_t )
+string_MK_SPLIT_N            ( char32_t )
+string_MK_SPLIT_BULK         ( char32_t )
+string_MK_SPLIT_OFFSETS      ( char32_t )
+string_MK_SPLIT_PARALLEL     ( char32_t )
+string_MK_SPLIT_QUOTED       ( char32_t )
+string_MK_RSPLIT             ( char32_t )
+string_MK_RSPLIT_VIEW        ( char32_t )
 string_MK_SPLIT_LEFT         ( char32_t )
 string_MK_SPLIT_RIGHT        ( char32_t )
+string_MK_SPLIT_ON           ( char32_t )
+string_MK_SPLIT_ON_VIEW      ( char32_t )
+string_MK_SPLIT_LEFT_ON      ( char32_t )
+string_MK_SPLIT_RIGHT_ON     ( char32_t )
+string_MK_SPLIT_PAIRS        ( char32_t )
+string_MK_SPLIT_PAIRS_VIEW   ( char32_t )
+string_MK_LINES              ( char32_t )
+string_MK_SCAN               ( char32_t )
+string_MK_SCAN_VALUES        ( char32_t )
+string_MK_HASH               ( char32_t )
+string_MK_MAKE_STRING_SWITCH ( char32_t )
+string_MK_PREFIX_SET         ( char32_t )
 // ...
 string_MK_COMPARE            ( char32_t )
 
@@ -2078,6 +7424,7 @@ string_MK_COMPARE_GT         ( char32_t )
 #undef string_MK_IS_EMPTY
 #undef string_MK_LENGTH
 #undef string_MK_SIZE
+#undef string_MK_COUNT_LINES
 #undef string_MK_APPEND
 #undef string_MK_CONTAINS
 #undef string_MK_CONTAINS_ALL_OF
@@ -2101,6 +7448,7 @@ string_MK_COMPARE_GT         ( char32_t )
 #undef string_MK_FIND_LAST_OF
 #undef string_MK_FIND_FIRST_NOT_OF
 #undef string_MK_FIND_LAST_NOT_OF
+#undef string_MK_FIND_ALL_OF
 #undef string_MK_ERASE
 #undef string_MK_ERASE_ALL
 #undef string_MK_ERASE_FIRST
@@ -2121,8 +7469,34 @@ string_MK_COMPARE_GT         ( char32_t )
 #undef string_MK_CAPITALIZE
 #undef string_MK_JOIN
 #undef string_MK_SPLIT
+#undef string_MK_SPLIT_VIEW
+#undef string_MK_SPLIT_INTO
+#undef string_MK_SPLIT_N
+#undef string_MK_SPLIT_BULK
+#undef string_MK_SPLIT_OFFSETS
+#undef string_MK_SPLIT_PARALLEL
+#undef string_MK_SPLIT_QUOTED
+#undef string_MK_SCAN
+#undef string_MK_SCAN_VALUES
+#undef string_MK_HASH
+#undef string_MK_MAKE_STRING_SWITCH
+#undef string_MK_PREFIX_SET
+#undef string_MK_RSPLIT
+#undef string_MK_SPLIT_OPTIONS
+#undef string_MK_STATIC_SET_FIND
+#undef string_MK_STATIC_SET_STRIP
+#undef string_MK_STATIC_SET_SPLIT
+#undef string_MK_RSPLIT_VIEW
+#undef string_MK_SPLIT_PARALLEL_THREADS
 #undef string_MK_SPLIT_LEFT
 #undef string_MK_SPLIT_RIGHT
+#undef string_MK_SPLIT_ON
+#undef string_MK_SPLIT_ON_VIEW
+#undef string_MK_SPLIT_LEFT_ON
+#undef string_MK_SPLIT_RIGHT_ON
+#undef string_MK_SPLIT_PAIRS
+#undef string_MK_SPLIT_PAIRS_VIEW
+#undef string_MK_LINES
 #undef string_MK_COMPARE
 #undef string_MK_COMPARE_EQ
 #undef string_MK_COMPARE_NE
@@ -2133,6 +7507,37 @@ string_MK_COMPARE_GT         ( char32_t )
 
 } // namespace nonstd
 
+namespace std {
+
+// std::hash for hashed_string_view, the stored hash:
+
+template< typename CharT >
+struct hash< nonstd::string::basic_hashed_string_view<CharT> >
+{
+    std::size_t operator()( nonstd::string::basic_hashed_string_view<CharT> const & text ) const string_noexcept
+    {
+        return static_cast<std::size_t>( text.hash() );
+    }
+};
+
+#if ! string_HAVE_STRING_VIEW
+
+// std::hash for the local string_view, to key unordered containers as with std::string_view in C++17:
+
+template< typename CharT, typename Traits >
+struct hash< nonstd::string::std17::basic_string_view<CharT, Traits> >
+{
+    std::size_t operator()( nonstd::string::std17::basic_string_view<CharT, Traits> text ) const string_noexcept
+    {
+        return static_cast<std::size_t>(
+            nonstd::string::detail::hash( nonstd::string::std17::basic_string_view<CharT>( text.data(), text.size() ), 0 ) );
+    }
+};
+
+#endif // ! string_HAVE_STRING_VIEW
+
+} // namespace std
+
 #endif  // NONSTD_STRING_BARE_HPP
 
 /*
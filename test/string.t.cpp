@@ -7,6 +7,11 @@
 
 #include "string-main.t.hpp"
 
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 #ifdef _WIN32
 # define string_strdup  _strdup
 #else
@@ -416,6 +421,19 @@ CASE( "find_last_not_of: position of last character in string not in set" )
     EXPECT( sv_npos == find_last_not_of(std17::string_view("abc123mno123xyz"), std17::string_view("abc123mno123xyz") ) );
 }
 
+// find_first_of<Set...>() etc.
+
+CASE( "find_first_of<Set...>: position of first, last character in string in, not in compile-time set" )
+{
+    EXPECT(      3 == ( find_first_of<'1', '2', '3'>("abc123mno123xyz") ) );
+    EXPECT(     11 == ( find_last_of<'1', '2', '3'>("abc123mno123xyz") ) );
+    EXPECT(      3 == ( find_first_not_of<'a', 'b', 'c'>("abc123mno123xyz") ) );
+    EXPECT(     11 == ( find_last_not_of<'x', 'y', 'z'>("abc123mno123xyz") ) );
+    EXPECT( sv_npos == ( find_first_of<'#', '\xff'>("abc123mno123xyz") ) );
+    EXPECT(      1 == ( find_first_of<'#', '\xff'>("a\xff" "b#") ) );
+    EXPECT( sv_npos == ( find_last_not_of<'a', 'b'>("abba") ) );
+}
+
 // Modifiers:
 
 // capitalize():
@@ -641,6 +659,16 @@ CASE( "strip: string with characters in set removed from left and right of strin
     EXPECT( strip(stringy(" #$%&abc #$%&"), " #$%&") == "abc" );
 }
 
+// strip<Set...>()
+
+CASE( "strip<Set...>: string with characters in compile-time set removed from left, right, left and right of string" )
+{
+    EXPECT( ( strip_left <' ', '#'>(" #abc# ") == "abc# " ) );
+    EXPECT( ( strip_right<' ', '#'>(" #abc# ") == " #abc" ) );
+    EXPECT( ( strip      <' ', '#'>(" #abc# ") == "abc" ) );
+    EXPECT( ( strip      <' ', '#'>(" ## ") == "" ) );
+}
+
 //
 // Join, split:
 //
@@ -655,6 +683,15 @@ make_vec_of_strings( char const * p="abc", char const * q="def", char const * r=
     return result;
 }
 
+template< typename Range >
+std::vector<std::string> to_vec_of_strings( Range const & range )
+{
+    std::vector<std::string> result;
+    for ( auto const & elem : range )
+        result.push_back( to_string( elem ) );
+    return result;
+}
+
 // join()
 
 CASE( "join: string with strings from collection joined separated by given separator" )
@@ -695,6 +732,179 @@ CASE( "split: split string into vector of string_view given set of delimiter cha
     }
 }
 
+// split<Set...>()
+
+CASE( "split<Set...>: split string into vector of string_view given compile-time set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz", "abc-123-xyz-789" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( ( split<'-', ',', ';', ':'>( text ) ) == split( text, "-,;:" ) );
+        EXPECT( ( split<'-', ',', ';', ':'>( text, 2 ) ) == split( text, "-,;:", 2 ) );
+    }
+}
+
+// split() with options
+
+CASE( "split: split string into vector of string_view given set of delimiter characters and split_options" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz", "abc-123-xyz-789" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( split( text, "-,;:", split_options() ) == split( text, "-,;:" ) );
+        EXPECT( split( text, "-,;:", split_options().max_count( 3 ) ) == split( text, "-,;:", 3 ) );
+    }
+
+    std::vector<std::string> golden;
+    golden.push_back( "abc" );
+    golden.push_back( "def" );
+    golden.push_back( "g h" );
+
+    EXPECT( split( " abc , ,def,  g h  ,", ",", split_options().skip_empty().trim( " " ) ) == golden );
+    EXPECT( split( " abc , ,def,  g h  ", ",", split_options().skip_empty().trim( " " ).max_count( 3 ) ) == golden );
+
+    std::vector<std::string> limited;
+    limited.push_back( "abc" );
+    limited.push_back( "def;g h;" );
+
+    EXPECT( split( ",abc,,def;g h;", ",;", split_options().skip_empty().max_count( 2 ) ) == limited );
+
+    std::vector<std::string> with_delims;
+    with_delims.push_back( "abc" );
+    with_delims.push_back( ",;" );
+    with_delims.push_back( "def" );
+    with_delims.push_back( ";" );
+
+    EXPECT( split( "abc,;def;", ",;", split_options().skip_empty().keep_delimiters() ) == with_delims );
+}
+
+// split_view() with options
+
+CASE( "split_view: lazy range of string_view given set of delimiter characters and split_options, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", " abc ", "abc - def-ghi", "-abc-def", " -abc- ", "--abc--", "abc,;:123;xyz", "abc-123-xyz-789" };
+
+    for ( auto text : texts )
+    {
+        for ( std::size_t n = 1; n != 5; ++n )
+        {
+            split_options const options = split_options().skip_empty( n % 2 == 0 ).trim( " " ).max_count( n ).keep_delimiters( n % 3 == 0 );
+
+            EXPECT( to_vec_of_strings( split_view( text, "-,;:", options ) ) == split( text, "-,;:", options ) );
+        }
+    }
+}
+
+// split_view()
+
+CASE( "split_view: lazy range of string_view given set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz", "abc-123-xyz-789" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( to_vec_of_strings( split_view( text, "-,;:" ) ) == split( text, "-,;:" ) );
+
+        for ( std::size_t Nsplit = 0; Nsplit < 5; ++Nsplit )
+        {
+            EXPECT( to_vec_of_strings( split_view( text, "-,;:", Nsplit ) ) == split( text, "-,;:", Nsplit ) );
+        }
+    }
+}
+
+CASE( "split_view: lazy range of string_view given set of delimiter characters - early exit" )
+{
+    auto range = split_view( "abc-def-ghi", "-" );
+    auto pos   = range.begin();
+
+    EXPECT( *pos   == std17::string_view("abc") );
+    EXPECT( *++pos == std17::string_view("def") );
+    EXPECT( *pos++ == std17::string_view("def") );
+    EXPECT( *pos   == std17::string_view("ghi") );
+    EXPECT( (  pos != range.end() ) );
+    EXPECT( (++pos == range.end() ) );
+
+#if string_HAVE_RANGES
+    static_assert( std::ranges::view<decltype(range)>, "split_view() must yield a view" );
+    static_assert( std::ranges::forward_range<decltype(range)>, "split_view() must yield a forward range" );
+#endif
+}
+
+// rsplit()
+
+CASE( "rsplit: split string from the right into vector of string_view given set of delimiter characters" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( rsplit( text, "-,;:" ) == split( text, "-,;:" ) );
+    }
+
+    EXPECT( rsplit("abc-123-xyz-789", "-", 3) == make_vec_of_strings("abc-123", "xyz", "789") );
+    EXPECT( rsplit("ab--12--xy-z", "-", 3) == make_vec_of_strings("ab--12", "xy", "z") );
+    EXPECT( rsplit("abc-123", "-", 1) == std::vector<std::string>( 1, "abc-123" ) );
+}
+
+// rsplit_view()
+
+CASE( "rsplit_view: lazy range of string_view from the right given set of delimiter characters" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz" };
+
+    for ( auto text : texts )
+    {
+        std::vector<std::string> golden = to_vec_of_strings( split( text, "-,;:" ) );
+        std::reverse( golden.begin(), golden.end() );
+
+        EXPECT( to_vec_of_strings( rsplit_view( text, "-,;:" ) ) == golden );
+    }
+
+    std::vector<std::string> golden;
+    golden.push_back( "member" );
+    golden.push_back( "ns.sub.class" );
+
+    EXPECT( to_vec_of_strings( rsplit_view( "ns.sub.class.member", ".", 2 ) ) == golden );
+}
+
+// split_into()
+
+CASE( "split_into: split string into output iterator given set of delimiter characters" )
+{
+    std::vector<std17::string_view> result;
+
+    split_into( "abc-def-ghi", "-", std::back_inserter( result ) );
+    EXPECT( result == make_vec_of_strings("abc", "def", "ghi") );
+
+    std17::string_view tokens[3];
+
+    EXPECT( split_into( "abc-123-xyz-789", "-", tokens, 3 ) == tokens + 3 );
+    EXPECT( std::vector<std17::string_view>( tokens, tokens + 3 ) == make_vec_of_strings("abc", "123", "xyz-789") );
+}
+
+// split_n()
+
+CASE( "split_n: split string into array of at most N string_view and count given set of delimiter characters" )
+{
+    std::array<std17::string_view, 3> tokens;
+    std::size_t count = 0;
+
+    std::tie( tokens, count ) = split_n<3>( "abc-def-ghi", "-" );
+    EXPECT( count == 3u );
+    EXPECT( std::vector<std17::string_view>( tokens.begin(), tokens.end() ) == make_vec_of_strings("abc", "def", "ghi") );
+
+    std::tie( tokens, count ) = split_n<3>( "abc-123-xyz-789", "-" );
+    EXPECT( count == 3u );
+    EXPECT( tokens[2] == std17::string_view("xyz-789") );
+
+    std::tie( tokens, count ) = split_n<3>( "abc;def", ";" );
+    EXPECT( count == 2u );
+    EXPECT( tokens[0] == std17::string_view("abc") );
+    EXPECT( tokens[1] == std17::string_view("def") );
+}
+
 // split_left()
 
 CASE( "split_left: split string into two-element tuple given set of delimiter characters - forward" )
@@ -731,6 +941,1225 @@ CASE( "split_right: split string into two-element tuple given set of delimiter c
     EXPECT( split_right("class::member", ":") == (std::tuple<std17::string_view, std17::string_view>("class", "member")) );
 }
 
+// find_all_of()
+
+CASE( "find_all_of: positions of all characters in string in set" )
+{
+    std::vector<std::size_t> golden;
+    golden.push_back( 3 ); golden.push_back( 4 ); golden.push_back( 8 );
+
+    EXPECT( find_all_of("abc,;123;xyz", ",;") == golden );
+    EXPECT( find_all_of("abc123xyz", ",;").empty() );
+    EXPECT( find_all_of("", ",;").empty() );
+
+    std::string text( 200, 'x' );
+    text[0] = text[63] = text[64] = text[199] = ',';
+
+    golden.clear();
+    golden.push_back( 0 ); golden.push_back( 63 ); golden.push_back( 64 ); golden.push_back( 199 );
+
+    EXPECT( find_all_of( text, ","      ) == golden );
+    EXPECT( find_all_of( text, ",;:\t\n" ) == golden );
+}
+
+// split_bulk()
+
+CASE( "split_bulk: split string into vector of string_view given set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( split_bulk( text, "-,;:" ) == to_vec_of_strings( split( text, "-,;:" ) ) );
+    }
+
+    std::string text;
+    for ( unsigned i = 0; i < 1000; ++i )
+        text += "abcdefg"[ ( i * 7919u ) % 7u ] + std::string( ( i * 31u ) % 5u, ",;\t\n\r"[ i % 5u ] );
+
+    char const * sets[] = { ",", ",;", ",;\t\n", ",;\t\n\r", "" };
+
+    for ( auto set : sets )
+    {
+        EXPECT( split_bulk( text, set ) == to_vec_of_strings( split( text, set ) ) );
+    }
+}
+
+// split_offsets()
+
+CASE( "split_offsets: split string into compact token table given set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( to_vec_of_strings( split_offsets( text, "-,;:" ) ) == to_vec_of_strings( split( text, "-,;:" ) ) );
+    }
+
+    std::string text( "abc,,def;ghi" );
+    auto const table = split_offsets( text, ",;" );
+
+    EXPECT( table.size() == 3u );
+    EXPECT( table[1] == "def" );
+    EXPECT( table.offset(2) == 9u );
+    EXPECT( table.length(2) == 3u );
+    EXPECT( table.text().data() == text.data() );
+    EXPECT( *( table.end() - 1 ) == "ghi" );
+    EXPECT( ( table.end() - table.begin() ) == 3 );
+}
+
+// csv_reader
+
+namespace {
+
+std::vector< std::vector<std::string> > read_csv( std::vector<std::string> const & chunks, char delimiter = ',' )
+{
+    std::vector< std::vector<std::string> > result;
+    csv_reader reader( delimiter );
+    csv_record record;
+
+    for ( auto const & chunk : chunks )
+    {
+        reader.feed( chunk );
+        while ( reader.next( record ) )
+            result.push_back( to_vec_of_strings( record ) );
+    }
+
+    reader.finish();
+    while ( reader.next( record ) )
+        result.push_back( to_vec_of_strings( record ) );
+
+    return result;
+}
+} // anonymous namespace
+
+CASE( "csv_reader: records of fields from RFC 4180 CSV text" )
+{
+    std::vector< std::vector<std::string> > golden;
+    golden.push_back( make_vec_of_strings( "abc", "", "x,y" ) );
+    golden.push_back( make_vec_of_strings( "line1\nline2", "say \"hi\"", "" ) );
+    golden.push_back( make_vec_of_strings( "last", "row", "" ) );
+
+    std::string const text = "abc,,\"x,y\"\r\n\n\"line1\nline2\",\"say \"\"hi\"\"\",\"\"\nlast,row,";
+
+    EXPECT( read_csv( std::vector<std::string>( 1, text ) ) == golden );
+    EXPECT( read_csv( std::vector<std::string>( 1, text + "\n" ) ) == golden );
+    EXPECT( read_csv( std::vector<std::string>( 1, "" ) ).empty() );
+}
+
+CASE( "csv_reader: records of fields from TSV text" )
+{
+    std::vector< std::vector<std::string> > golden;
+    golden.push_back( make_vec_of_strings( "a", "b,c", "d\te" ) );
+
+    EXPECT( read_csv( std::vector<std::string>( 1, "a\tb,c\t\"d\te\"\n" ), '\t' ) == golden );
+}
+
+CASE( "csv_reader: records of fields from CSV text in chunks, same as in one piece" )
+{
+    char const * fields[] = { "abc", "\"de,f\"", "\"g\"\"h\"\"\"", "\"multi\nline\"", "" };
+
+    std::string text;
+    for ( unsigned i = 0; i < 40; ++i )
+        text += fields[ i % 5 ] + std::string( "," ) + fields[ i * 3 % 5 ] + "," + std::string( i * 7 % 90, 'x' ) + ( i % 2 ? "\r\n" : "\n" );
+
+    auto const golden = read_csv( std::vector<std::string>( 1, text ) );
+
+    EXPECT( golden.size() == 40u );
+
+    for ( std::size_t size = 1; size < 150; size += 7 )
+    {
+        std::vector<std::string> chunks;
+        for ( std::size_t pos = 0; pos < text.size(); pos += size )
+            chunks.push_back( text.substr( pos, size ) );
+
+        EXPECT( read_csv( chunks ) == golden );
+    }
+}
+
+// tokenizer
+
+namespace {
+
+std::vector<std::string> tokenize( std::string const & text, std::size_t size, char const * set )
+{
+    std::vector<std::string> result;
+    tokenizer tok( set );
+    std17::string_view token;
+
+    for ( std::size_t pos = 0; pos < text.size(); pos += size )
+    {
+        tok.feed( std17::string_view( text ).substr( pos, size ) );
+        while ( tok.next( token ) )
+            result.push_back( to_string( token ) );
+    }
+
+    tok.finish();
+    while ( tok.next( token ) )
+        result.push_back( to_string( token ) );
+
+    return result;
+}
+} // anonymous namespace
+
+CASE( "tokenizer: tokens of string fed in chunks given set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz", "a-b--c---d----e" };
+
+    for ( auto text : texts )
+    {
+        for ( std::size_t size = 1; size != 8; ++size )
+        {
+            EXPECT( tokenize( text, size, "-,;:" ) == to_vec_of_strings( split( text, "-,;:" ) ) );
+        }
+    }
+
+    std::string text;
+    for ( unsigned i = 0; i < 300; ++i )
+        text += std::string( i * 7 % 11, "abcdefg"[ i % 7u ] ) + std::string( i * 31 % 4, ",;\t\n"[ i % 4u ] );
+
+    for ( std::size_t size = 1; size < 200; size += 11 )
+    {
+        EXPECT( tokenize( text, size, ",;\t\n" ) == to_vec_of_strings( split( text, ",;\t\n" ) ) );
+    }
+}
+
+// split_quoted()
+
+CASE( "split_quoted: split string into tokens given sets of delimiter and quote characters and escape character" )
+{
+    std::vector<std::string> golden;
+    golden.push_back( "cmd" );
+    golden.push_back( "hello world" );
+    golden.push_back( "it's" );
+    golden.push_back( "a b" );
+    golden.push_back( "" );
+    golden.push_back( "x\"y" );
+
+    EXPECT( to_vec_of_strings( split_quoted( "  cmd \"hello world\" it\\'s a\\ b '' 'x\"y'  ", " \t", "\"'" ) ) == golden );
+
+    EXPECT( to_vec_of_strings( split_quoted( " abc  def ghi ", " ", "\"'" ) ) == make_vec_of_strings( "abc", "def", "ghi" ) );
+    EXPECT( to_vec_of_strings( split_quoted( "a\"b c\"d \"e\" \"\"", " ", "\"" ) ) == make_vec_of_strings( "ab cd", "e", "" ) );
+    EXPECT( split_quoted( "", " ", "\"" ).empty() );
+    EXPECT( split_quoted( "   ", " ", "\"" ).empty() );
+}
+
+CASE( "split_quoted: tokens refer to the text unless unescaping is needed" )
+{
+    std::string const text( "abc \"d e\" f\\ g" );
+    auto const tokens = split_quoted( text, " ", "\"" );
+
+    EXPECT( tokens.size() == 3u );
+    EXPECT( tokens[0].data() == text.data() );
+    EXPECT( tokens[1].data() == text.data() + 5 );
+    EXPECT( tokens[2] == "f g" );
+}
+
+// split_parallel()
+
+namespace {
+
+struct sequential_executor
+{
+    template< typename Task >
+    void operator()( std::size_t count, Task task ) const
+    {
+        for ( std::size_t i = count; i-- != 0; )
+            task( i );
+    }
+};
+} // anonymous namespace
+
+CASE( "split_parallel: split string in chunks into vector of string_view given set of delimiter characters, same elements as split()" )
+{
+    char const * texts[] = { "", "-", "--", "abc", "abc-def-ghi", "-abc-def", "-abc-", "--abc--", "abc,;:123;xyz", "a-b--c---d----e" };
+
+    for ( auto text : texts )
+    {
+        for ( std::size_t n = 1; n != 20; ++n )
+        {
+            EXPECT( split_parallel( text, "-,;:", n, sequential_executor() ) == to_vec_of_strings( split( text, "-,;:" ) ) );
+        }
+    }
+
+    std::string text;
+    for ( unsigned i = 0; i < 1000; ++i )
+        text += "abcdefg"[ ( i * 7919u ) % 7u ] + std::string( ( i * 31u ) % 5u, ",;\t\n\r"[ i % 5u ] );
+
+    for ( std::size_t n = 1; n < 300; n += 13 )
+    {
+        EXPECT( split_parallel( text, ",;\t\n\r", n, sequential_executor() ) == to_vec_of_strings( split( text, ",;\t\n\r" ) ) );
+    }
+
+#if string_CONFIG_PROVIDE_THREADS
+    std::string large;
+    while ( large.size() < 1000000u )
+        large += text;
+
+    EXPECT( split_parallel( large, ",;\t\n\r" ) == to_vec_of_strings( split( large, ",;\t\n\r" ) ) );
+#endif
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+CASE( "split_parallel: thread executor runs all tasks and rethrows an exception of a task after joining its threads" )
+{
+    for ( std::size_t failing = 0; failing != 4; ++failing )
+    {
+        std::vector<int> done( 4, 0 );
+
+        EXPECT_THROWS_AS( nonstd::string::detail::thread_executor()( done.size(), [&done, failing]( std::size_t i )
+        {
+            done[i] = 1;
+
+            if ( i == failing )
+                throw std::runtime_error( "task" );
+        } ), std::runtime_error );
+
+        EXPECT( done == std::vector<int>( 4, 1 ) );
+    }
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+// split_on()
+
+CASE( "split_on: split string into vector of string_view given delimiter string" )
+{
+    EXPECT( split_on("abc::def::ghi", "::") == make_vec_of_strings("abc", "def", "ghi") );
+    EXPECT( split_on("::abc::def"   , "::") == make_vec_of_strings("", "abc", "def") );
+    EXPECT( split_on("abc::::def"   , "::") == make_vec_of_strings("abc", "", "def") );
+    EXPECT( split_on("abc::def::"   , "::") == make_vec_of_strings("abc", "def", "") );
+    EXPECT( split_on("abc:def:ghi"  , "::") == std::vector<std::string>( 1, "abc:def:ghi" ) );
+    EXPECT( split_on("abc\r\ndef\r\nghi\r\nxyz", "\r\n", 3) == make_vec_of_strings("abc", "def", "ghi\r\nxyz") );
+    EXPECT( split_on("abc", "") == std::vector<std::string>( 1, "abc" ) );
+    EXPECT( split_on("", "::") == std::vector<std::string>( 1, "" ) );
+}
+
+// split_on_view()
+
+CASE( "split_on_view: lazy range of string_view given delimiter string, same elements as split_on()" )
+{
+    char const * texts[] = { "", "::", "abc", "abc::def::ghi", "::abc::def", "abc::::def", "abc::def::", "a:b::c:::d" };
+
+    for ( auto text : texts )
+    {
+        for ( std::size_t Nsplit = 0; Nsplit < 5; ++Nsplit )
+        {
+            EXPECT( to_vec_of_strings( split_on_view( text, "::", Nsplit ) ) == split_on( text, "::", Nsplit ) );
+        }
+        EXPECT( to_vec_of_strings( split_on_view( text, "::" ) ) == split_on( text, "::" ) );
+    }
+}
+
+// split_left_on()
+
+CASE( "split_left_on: split string into two-element tuple given delimiter string - forward" )
+{
+    EXPECT( split_left_on("abc -- def -- ghi", " -- ") == (std::tuple<std17::string_view, std17::string_view>("abc", "def -- ghi")) );
+    EXPECT( split_left_on("abc -- "          , " -- ") == (std::tuple<std17::string_view, std17::string_view>("abc", "")) );
+    EXPECT( split_left_on("abc - def"        , " -- ") == (std::tuple<std17::string_view, std17::string_view>("abc - def", "abc - def")) );
+    EXPECT( split_left_on("class::member"    , "::"  ) == (std::tuple<std17::string_view, std17::string_view>("class", "member")) );
+}
+
+// split_right_on()
+
+CASE( "split_right_on: split string into two-element tuple given delimiter string - reverse" )
+{
+    EXPECT( split_right_on("abc -- def -- ghi", " -- ") == (std::tuple<std17::string_view, std17::string_view>("abc -- def", "ghi")) );
+    EXPECT( split_right_on(" -- abc"          , " -- ") == (std::tuple<std17::string_view, std17::string_view>("", "abc")) );
+    EXPECT( split_right_on("abc - def"        , " -- ") == (std::tuple<std17::string_view, std17::string_view>("abc - def", "abc - def")) );
+    EXPECT( split_right_on("ns::class::member", "::"  ) == (std::tuple<std17::string_view, std17::string_view>("ns::class", "member")) );
+}
+
+// split_pairs()
+
+namespace {
+
+typedef std::vector< std::pair<std::string, std::string> > pairs_t;
+
+template< typename Range >
+pairs_t to_vec_of_pairs( Range const & range )
+{
+    pairs_t result;
+    for ( auto const & kv : range )
+        result.push_back( std::make_pair( to_string( kv.first ), to_string( kv.second ) ) );
+    return result;
+}
+
+pairs_t make_pairs( char const * k1, char const * v1, char const * k2, char const * v2, char const * k3, char const * v3 )
+{
+    pairs_t result;
+    result.push_back( std::make_pair( k1, v1 ) );
+    result.push_back( std::make_pair( k2, v2 ) );
+    result.push_back( std::make_pair( k3, v3 ) );
+    return result;
+}
+} // anonymous namespace
+
+CASE( "split_pairs: split string into vector of key-value pairs given sets of pair and key-value separator characters" )
+{
+    EXPECT( ( to_vec_of_pairs( split_pairs("k1=v1&k2=v2&k3=v3", "&", "=") ) == make_pairs("k1", "v1", "k2", "v2", "k3", "v3") ) );
+    EXPECT( ( to_vec_of_pairs( split_pairs("k1=v1;;k2;k3=a=b;", ";", "=") ) == make_pairs("k1", "v1", "k2", "", "k3", "a=b") ) );
+    EXPECT( ( to_vec_of_pairs( split_pairs("id=42; lang = en ;  x=", ";", "=", " ") ) == make_pairs("id", "42", "lang", "en", "x", "") ) );
+    EXPECT( split_pairs("", ";", "=").empty() );
+    EXPECT( split_pairs(" ; ;", ";", "=", " ").empty() );
+}
+
+CASE( "split_pairs_view: lazy range of key-value pairs given sets of pair and key-value separator characters, same elements as split_pairs()" )
+{
+    char const * texts[] = { "", ";", "k1=v1&k2=v2&k3=v3", "k1=v1;;k2;k3=a=b;", "id=42; lang = en ;  x=", "=;=x;y=" };
+
+    for ( auto text : texts )
+    {
+        EXPECT( ( to_vec_of_pairs( split_pairs_view( text, ";&", "=", " " ) ) == to_vec_of_pairs( split_pairs( text, ";&", "=", " " ) ) ) );
+    }
+}
+
+// lines()
+
+CASE( "lines: lazy range of lines of string, terminated by LF or CR-LF [or CR], terminators excluded" )
+{
+    EXPECT( to_vec_of_strings( lines("abc\ndef\r\nghi") ) == make_vec_of_strings("abc", "def", "ghi") );
+    EXPECT( to_vec_of_strings( lines("abc\n\nghi\n") ) == make_vec_of_strings("abc", "", "ghi") );
+    EXPECT( to_vec_of_strings( lines("abc\rdef\n") ) == std::vector<std::string>( 1, "abc\rdef" ) );
+    EXPECT( to_vec_of_strings( lines("abc\rdef\r\nghi\r", true) ) == make_vec_of_strings("abc", "def", "ghi") );
+    EXPECT( to_vec_of_strings( lines("\n") ) == std::vector<std::string>( 1, "" ) );
+    EXPECT( to_vec_of_strings( lines("") ).empty() );
+}
+
+// count_lines()
+
+CASE( "count_lines: number of lines in string, terminated by LF or CR-LF [or CR]" )
+{
+    EXPECT( count_lines("") == 0u );
+    EXPECT( count_lines("abc") == 1u );
+    EXPECT( count_lines("abc\n") == 1u );
+    EXPECT( count_lines("abc\r\n\ndef") == 3u );
+    EXPECT( count_lines("abc\rdef\r\n") == 1u );
+    EXPECT( count_lines("abc\rdef\r\n", true) == 2u );
+    EXPECT( count_lines("abc\r\rdef\r", true) == 3u );
+
+    std::string text;
+    for ( unsigned i = 0; i < 500; ++i )
+        text += std::string( i * 7 % 13, 'x' ) + ( i % 3 == 0 ? "\n" : i % 3 == 1 ? "\r\n" : "\r" );
+
+    for ( std::size_t n = 0; n < text.size(); n += 61 )
+    {
+        std17::string_view const sv( text.data(), n );
+
+        EXPECT( count_lines( sv       ) == to_vec_of_strings( lines( sv       ) ).size() );
+        EXPECT( count_lines( sv, true ) == to_vec_of_strings( lines( sv, true ) ).size() );
+    }
+}
+
+// scan()
+
+CASE( "scan: match pattern with literals and fields into views and numbers" )
+{
+    std17::string_view host, method, path;
+    int day = 0;
+    unsigned status = 0;
+    double seconds = 0;
+
+    std::string const line( "10.0.0.1 - [17] \"GET /index.html\" 200 0.25 trailing" );
+
+    scan_result const result = scan( line, "{} - [{}] \"{} {}\" {} {} ", host, day, method, path, status, seconds );
+
+    EXPECT( result.matched );
+    EXPECT( result.end == line.size() - 8 );
+    EXPECT( host == "10.0.0.1" );
+    EXPECT( day == 17 );
+    EXPECT( method == "GET" );
+    EXPECT( path == "/index.html" );
+    EXPECT( status == 200u );
+    EXPECT( seconds == 0.25 );
+    EXPECT( host.data() == line.data() );
+
+    EXPECT( scan( "{x}=-42", "{{x}}={}", day ).matched );
+    EXPECT( day == -42 );
+    EXPECT( scan( "a-b", "{}-{}", method, path ).end == 3u );
+    EXPECT( method == "a" );
+    EXPECT( path == "b" );
+}
+
+CASE( "scan: not matched on literal mismatch, number out of range or not filling its field, field count mismatch" )
+{
+    int i = 0;
+    std::int32_t i32 = 0;
+    unsigned char u = 0;
+    double d = 0;
+    std17::string_view v;
+
+    EXPECT_NOT( scan( "x=1", "y={}", i ).matched );
+    EXPECT_NOT( scan( "x=1;", "x={},", i ).matched );
+    EXPECT_NOT( scan( "x=1a", "x={}", i ).matched );
+    EXPECT_NOT( scan( "x=", "x={}", i ).matched );
+    EXPECT_NOT( scan( "x=256", "x={}", u ).matched );
+    EXPECT_NOT( scan( "x=-1", "x={}", u ).matched );
+    EXPECT_NOT( scan( "x= 1.5", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=+-1.5", "x={}", d ).matched );
+    EXPECT( scan( "x=+1.5e3", "x={}", d ).matched );
+    EXPECT( d == 1500.0 );
+    EXPECT_NOT( scan( "x=1", "x={}", i, v ).matched );
+    EXPECT_NOT( scan( "x=1", "{}={}", v ).matched );
+    EXPECT_NOT( scan( "ab", "{}{}", v, i ).matched );
+    EXPECT_NOT( scan( "x=2147483648", "x={}", i32 ).matched );
+    EXPECT( scan( "x=-2147483648", "x={}", i32 ).matched );
+    EXPECT( i32 == (std::numeric_limits<std::int32_t>::min)() );
+    EXPECT( scan( "x=255", "x={}", u ).matched );
+    EXPECT( u == 255 );
+}
+
+CASE( "scan: floating point the same with and without std::from_chars(): decimal only, out of range not matched" )
+{
+    double d = 0;
+    float f = 0;
+
+    EXPECT_NOT( scan( "x=1e999", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=-1e999", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=1e-999", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=1e39", "x={}", f ).matched );
+    EXPECT_NOT( scan( "x=0x1p3", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=-0X1P3", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=1,5", "x={}", d ).matched );
+    EXPECT_NOT( scan( "x=1e", "x={}", d ).matched );
+    EXPECT( scan( "x=1e-310", "x={}", d ).matched );
+    EXPECT( d > 0 );
+    EXPECT( scan( "x=-inf", "x={}", d ).matched );
+    EXPECT( d == -(std::numeric_limits<double>::infinity)() );
+    EXPECT( scan( "x=.5", "x={}", d ).matched );
+    EXPECT( d == 0.5 );
+    EXPECT( scan( "x=0", "x={}", d ).matched );
+    EXPECT( d == 0.0 );
+}
+
+CASE( "scan: tuple of result and fields as given types" )
+{
+    auto const values = scan<int, std17::string_view, double>( "7: seven 7.5", "{}: {} {}" );
+
+    EXPECT( std::get<0>( values ).matched );
+    EXPECT( std::get<1>( values ) == 7 );
+    EXPECT( std::get<2>( values ) == "seven" );
+    EXPECT( std::get<3>( values ) == 7.5 );
+
+    EXPECT_NOT( std::get<0>( scan<int>( "seven", "{}" ) ).matched );
+}
+
+// hash()
+
+CASE( "hash: 64-bit hash of string, of the bytes of its characters in little-endian order" )
+{
+    std::set<std::uint64_t> hashes;
+
+    for ( std::size_t n = 0; n <= 100; ++n )
+        hashes.insert( hash( std::string( n, 'a' ) ) );
+
+    EXPECT( hashes.size() == 101u );
+    EXPECT( hash( "abc" ) == hash( std::string( "abc" ) ) );
+    EXPECT( hash( "abc" ) != hash( "abd" ) );
+    EXPECT( hash( "abc" ) != hash( "abc", 1u ) );
+    EXPECT( hash( std17::string_view( "abc\0def", 7 ) ) != hash( "abc" ) );
+#if string_CONFIG_PROVIDE_CHAR16_T
+    EXPECT( hash( u"ab" ) == hash( std17::string_view( "a\0b\0", 4 ) ) );
+#endif
+#if string_CPP14_OR_GREATER
+    constexpr std::uint64_t h = hash( std17::string_view( "abc", 3 ) );
+    EXPECT( h == hash( "abc" ) );
+#endif
+}
+
+CASE( "string_hash, string_equal: transparent hasher and equality for unordered containers of strings" )
+{
+    std::unordered_map<std::string, int, string_hash, string_equal> map;
+    map["abc"] = 1;
+    map["def"] = 2;
+
+    EXPECT( map.count( "abc" ) == 1u );
+    EXPECT( string_hash()( "abc" ) == string_hash()( std::string( "abc" ) ) );
+    EXPECT( string_hash()( "abc" ) == string_hash()( std17::string_view( "abc" ) ) );
+    EXPECT( string_hash()( "abc" ) == static_cast<std::size_t>( hash( "abc" ) ) );
+    EXPECT(     string_equal()( std::string( "abc" ), "abc" ) );
+    EXPECT(     string_equal()( std17::string_view( "abc" ), std::string( "abc" ) ) );
+    EXPECT_NOT( string_equal()( std17::string_view( "abc" ), std::string( "abd" ) ) );
+#if defined( __cpp_lib_generic_unordered_lookup )
+    EXPECT( map.find( std17::string_view( "def" ) )->second == 2 );
+#endif
+}
+
+CASE( "std::hash: string_view keys unordered container, also for local string_view" )
+{
+    std::unordered_set<std17::string_view> set;
+    set.insert( std17::string_view( "abc" ) );
+
+    EXPECT( set.count( std17::string_view( "abc" ) ) == 1u );
+    EXPECT( set.count( std17::string_view( "def" ) ) == 0u );
+}
+
+// hashed_string_view
+
+CASE( "hashed_string_view: string view with its hash, compared by hash first, converts to string_view" )
+{
+    std::string const text( "abc" );
+    hashed_string_view const a( text );
+    hashed_string_view const b( std17::string_view( "abc" ) );
+    hashed_string_view const c( "abd" );
+
+    EXPECT( a.hash() == hash( "abc" ) );
+    EXPECT( a.data() == text.data() );
+    EXPECT( a.size() == 3u );
+    EXPECT( a == b );
+    EXPECT( a != c );
+    EXPECT( a <  c );
+    EXPECT( c >= a );
+    EXPECT( a == std17::string_view( "abc" ) );
+    EXPECT( std17::string_view( "abd" ) != a );
+    EXPECT( contains( a, "bc" ) );
+    EXPECT( hashed_string_view().hash() == hash( "" ) );
+    EXPECT( hashed_string_view( a.view(), a.hash() ) == a );
+#if string_CPP14_OR_GREATER
+    constexpr hashed_string_view h( std17::string_view( "abc", 3 ) );
+    EXPECT( h.hash() == hash( "abc" ) );
+#endif
+}
+
+CASE( "hashed_string_view: string_hash, string_equal and std::hash use its stored hash" )
+{
+    hashed_string_view const key( "def" );
+
+    EXPECT( string_hash()( key ) == string_hash()( "def" ) );
+    EXPECT( std::hash<hashed_string_view>()( key ) == string_hash()( "def" ) );
+    EXPECT(     string_equal()( key, std::string( "def" ) ) );
+    EXPECT(     string_equal()( key, hashed_string_view( "def" ) ) );
+    EXPECT_NOT( string_equal()( key, hashed_string_view( "abc" ) ) );
+
+    std::unordered_set<hashed_string_view> set;
+    set.insert( hashed_string_view( "abc" ) );
+    set.insert( key );
+
+    EXPECT( set.count( key ) == 1u );
+    EXPECT( set.count( hashed_string_view( "ghi" ) ) == 0u );
+#if defined( __cpp_lib_generic_unordered_lookup )
+    std::unordered_map<std::string, int, string_hash, string_equal> map;
+    map["def"] = 2;
+
+    EXPECT( map.find( key )->second == 2 );
+#endif
+}
+
+// string_switch
+
+CASE( "string_switch: index of string among fixed set of keys, or npos, with one hash and one comparison" )
+{
+    auto const method = make_string_switch( "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH" );
+
+    EXPECT( method.size() == 9u );
+    EXPECT( method( "GET" ) == 0u );
+    EXPECT( method( std::string( "PATCH" ) ) == 8u );
+    EXPECT( method( "get" ) == npos );
+    EXPECT( method( "GETS" ) == npos );
+    EXPECT( method( "" ) == npos );
+
+    for ( std::size_t i = 0; i < method.size(); ++i )
+        EXPECT( method( method[i] ) == i );
+
+    std::vector<std::string> texts;
+    for ( unsigned i = 0; i < 300; ++i )
+        texts.push_back( "key-" + std::to_string( i ) );
+
+    std17::string_view keys[300];
+    for ( std::size_t i = 0; i < texts.size(); ++i )
+        keys[i] = texts[i];
+
+    basic_string_switch<char, 300> const many( keys );
+
+    for ( std::size_t i = 0; i < texts.size(); ++i )
+        EXPECT( many( texts[i] ) == i );
+
+    EXPECT( many( "key-300" ) == npos );
+#if ! string_CONFIG_NO_EXCEPTIONS
+    EXPECT_THROWS_AS( (void) make_string_switch( "abc", "def", "abc" ), std::invalid_argument );
+#endif
+}
+
+CASE( "string_switch: built at compile time (C++14), from template arguments (C++20)" )
+{
+#if string_CPP14_OR_GREATER
+    constexpr auto sw = make_string_switch( "alpha", "beta", "gamma" );
+
+    std::size_t result = npos;
+
+    switch ( sw( std17::string_view( "beta" ) ) )
+    {
+        case sw( std17::string_view( "alpha", 5 ) ): result = 0; break;
+        case sw( std17::string_view( "beta" , 4 ) ): result = 1; break;
+        case sw( std17::string_view( "gamma", 5 ) ): result = 2; break;
+        default: break;
+    }
+
+    EXPECT( result == 1u );
+#else
+    auto const sw = make_string_switch( "alpha", "beta", "gamma" );
+
+    EXPECT( sw( "beta" ) == 1u );
+    EXPECT( sw( "delta" ) == npos );
+#endif
+#if string_HAVE_CLASS_NTTP
+    EXPECT( ( string_switch<"GET", "POST", "PUT">( "POST" ) == 1u ) );
+    EXPECT( ( string_switch<"GET", "POST", "PUT">( "DELETE" ) == npos ) );
+#endif
+}
+
+// intern_pool
+
+CASE( "intern_pool: unique strings with dense ids, id to string and string to id" )
+{
+    intern_pool pool;
+
+    EXPECT( pool.empty() );
+    EXPECT( pool.intern( "abc" ) == 0u );
+    EXPECT( pool.intern( "def" ) == 1u );
+    EXPECT( pool.intern( std::string( "abc" ) ) == 0u );
+    EXPECT( pool.intern( "" ) == 2u );
+    EXPECT( pool.size() == 3u );
+    EXPECT( pool[0] == "abc" );
+    EXPECT( pool[1] == "def" );
+    EXPECT( pool[2] == "" );
+    EXPECT( to_vec_of_strings( pool ) == make_vec_of_strings( "abc", "def", "" ) );
+
+    intern_pool::id_type id = 0;
+
+    EXPECT(     pool.find( "def", id ) );
+    EXPECT( id == 1u );
+    EXPECT_NOT( pool.find( "ghi", id ) );
+
+    pool.clear();
+
+    EXPECT( pool.empty() );
+    EXPECT_NOT( pool.find( "abc", id ) );
+}
+
+CASE( "intern_pool: views stay valid while the pool grows, strings are copied into the pool" )
+{
+    intern_pool pool( 16 );
+    std::string text( "text-0" );
+
+    EXPECT( pool.intern( text ) == 0u );
+
+    std17::string_view const first = pool[0];
+    text[0] = 'T';
+
+    for ( unsigned i = 0; i < 2000; ++i )
+        EXPECT( pool.intern( std::to_string( i ) ) == i + 1 );
+
+    std::string const long_text( 100, 'x' );
+
+    EXPECT( pool.intern( long_text ) == 2001u );
+    EXPECT( pool[2001] == long_text );
+    EXPECT( static_cast<void const *>( pool[0].data() ) == static_cast<void const *>( first.data() ) );
+    EXPECT( pool[0] == "text-0" );
+    EXPECT( pool.intern( "1999" ) == 2000u );
+
+    intern_pool::statistics const stats = pool.stats();
+
+    EXPECT( stats.strings == 2002u );
+    EXPECT( stats.characters == 6u + 10u + 90u * 2u + 900u * 3u + 1000u * 4u + 100u );
+    EXPECT( stats.arena_bytes >= stats.characters );
+    EXPECT( stats.index_bytes > 0u );
+}
+
+CASE( "intern_pool: ids of the strings of a range, such as from split() or split_view()" )
+{
+    intern_pool pool;
+
+    std::vector<intern_pool::id_type> const ids = pool.intern( split( "a b a c b", " " ) );
+    std::vector<intern_pool::id_type> const lazy_ids = pool.intern( split_view( "c a b", " " ) );
+
+    EXPECT( ids.size() == 5u );
+    EXPECT( ids[0] == 0u );
+    EXPECT( ids[1] == 1u );
+    EXPECT( ids[2] == 0u );
+    EXPECT( ids[3] == 2u );
+    EXPECT( ids[4] == 1u );
+    EXPECT( lazy_ids.size() == 3u );
+    EXPECT( lazy_ids[0] == 2u );
+    EXPECT( lazy_ids[1] == 0u );
+    EXPECT( lazy_ids[2] == 1u );
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+// concurrent_intern_pool
+
+CASE( "concurrent_intern_pool: unique strings with dense ids, interned from several threads" )
+{
+    concurrent_intern_pool pool( 4, 64 );
+
+    std::vector<std::string> texts;
+    for ( unsigned i = 0; i < 3000; ++i )
+        texts.push_back( "text-" + std::to_string( i ) );
+
+    std::vector< std::vector<concurrent_intern_pool::id_type> > ids( 4, std::vector<concurrent_intern_pool::id_type>( texts.size() ) );
+    std::vector<std::thread> threads;
+    std::size_t const step[] = { 1, 7, 11, 13 };
+
+    for ( std::size_t t = 0; t < ids.size(); ++t )
+    {
+        threads.push_back( std::thread( [&, t]()
+        {
+            for ( std::size_t k = 0; k < texts.size(); ++k )
+            {
+                std::size_t const i = ( k * step[t] + t * 977 ) % texts.size();   // permutation per thread
+                ids[t][i] = pool.intern( texts[i] );
+            }
+        }));
+    }
+
+    for ( auto & thread : threads )
+        thread.join();
+
+    EXPECT( pool.size() == texts.size() );
+
+    for ( std::size_t i = 0; i < texts.size(); ++i )
+    {
+        concurrent_intern_pool::id_type id = 0;
+
+        EXPECT( pool.find( texts[i], id ) );
+        EXPECT( id == ids[0][i] );
+        EXPECT( id == ids[1][i] );
+        EXPECT( id == ids[2][i] );
+        EXPECT( id == ids[3][i] );
+        EXPECT( pool[id] == texts[i] );
+    }
+
+    concurrent_intern_pool::id_type id = 0;
+
+    EXPECT_NOT( pool.find( "text-3000", id ) );
+    EXPECT( pool.intern( "text-3000" ) == 3000u );
+    EXPECT( pool[3000] == "text-3000" );
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+// prefix_set, suffix_set
+
+CASE( "prefix_set: longest key that string starts with, starts_with_any()" )
+{
+    prefix_set routes{ "/", "/api/", "/api/v1/", "/static/", "/api/" };
+
+    EXPECT( routes.size() == 4u );
+    EXPECT( longest_prefix_match( "/api/v1/users", routes ) == 8u );
+    EXPECT( longest_prefix_match( "/api/v2/users", routes ) == 5u );
+    EXPECT( longest_prefix_match( "/apix"        , routes ) == 1u );
+    EXPECT( longest_prefix_match( "api/"         , routes ) == npos );
+    EXPECT( longest_prefix_match( ""             , routes ) == npos );
+
+    EXPECT(     starts_with_any( "/static/logo.png", routes ) );
+    EXPECT_NOT( starts_with_any( "static/logo.png" , routes ) );
+
+    EXPECT(     routes.contains( "/api/" ) );
+    EXPECT_NOT( routes.contains( "/api" ) );
+    EXPECT_NOT( routes.contains( "/api/v" ) );
+}
+
+CASE( "prefix_set: empty key, empty set, built from a range such as of split()" )
+{
+    std::vector<std::string> keys = make_vec_of_strings( "abc", "abd", "ab" );
+
+    EXPECT( longest_prefix_match( "abx", prefix_set( keys ) ) == 2u );
+    EXPECT( longest_prefix_match( "abd", prefix_set( split( "abc,ab,abd", "," ) ) ) == 3u );
+    EXPECT( longest_prefix_match( "x"  , prefix_set{ "", "a" } ) == 0u );
+    EXPECT( longest_prefix_match( ""   , prefix_set{ "" } ) == 0u );
+    EXPECT( longest_prefix_match( "x"  , prefix_set() ) == npos );
+    EXPECT( prefix_set().empty() );
+}
+
+CASE( "prefix_set: same as checking each key, for many keys" )
+{
+    std::vector<std::string> keys;
+
+    for ( int i = 0; i < 2000; ++i )
+        keys.push_back( to_string( "k" ) + std::to_string( i * 7919 % 100003 ) );
+
+    prefix_set const set( keys );
+
+    for ( int i = 0; i < 3000; ++i )
+    {
+        std::string const text = to_string( "k" ) + std::to_string( i * 104729 % 1000033 );
+
+        std::size_t expected = npos;
+        for ( std::string const & key : keys )
+        {
+            if ( starts_with( text, key ) && ( expected == npos || key.size() > expected ) )
+                expected = key.size();
+        }
+
+        EXPECT( longest_prefix_match( text, set ) == expected );
+    }
+}
+
+CASE( "prefix_set, suffix_set: more than 16 keys that differ in the first character, also above 0x7f" )
+{
+    std::vector<std::string> keys;
+
+    for ( char chr = 'a'; chr <= 't'; ++chr )
+        keys.push_back( std::string( 1, chr ) + "x" );
+
+    keys.push_back( "\xC3\xA9t\xC3\xA9" );
+    keys.push_back( "\xFF" );
+
+    prefix_set const prefixes( keys );
+    suffix_set const suffixes( keys );
+
+    for ( std::string const & key : keys )
+    {
+        std::string const reversed( key.rbegin(), key.rend() );
+
+        EXPECT( prefixes.contains( key ) );
+        EXPECT( longest_prefix_match( key + "!", prefixes ) == key.size() );
+        EXPECT( suffixes.contains( key ) );
+        EXPECT( longest_suffix_match( "!" + key, suffixes ) == key.size() );
+        EXPECT_NOT( suffixes.contains( reversed == key ? "?" : reversed ) );
+    }
+
+    EXPECT( longest_prefix_match( "\xC3\xA9", prefixes ) == npos );
+    EXPECT( longest_suffix_match( "\xC3\xA9", suffixes ) == npos );
+}
+
+CASE( "suffix_set: longest key that string ends with, ends_with_any()" )
+{
+    suffix_set images{ ".jpg", ".jpeg", ".png", "g" };
+
+    EXPECT( longest_suffix_match( "photo.jpeg", images ) == 5u );
+    EXPECT( longest_suffix_match( "photo.jpg" , images ) == 4u );
+    EXPECT( longest_suffix_match( "song.ogg"  , images ) == 1u );
+    EXPECT( longest_suffix_match( "notes.txt" , images ) == npos );
+
+    EXPECT(     ends_with_any( "logo.png", images ) );
+    EXPECT_NOT( ends_with_any( "logo.svx", images ) );
+    EXPECT(     images.contains( ".png" ) );
+}
+
+// sort_strings()
+
+namespace {
+
+// strings with long common prefixes, empty strings and characters above 0x7f:
+
+std::vector<std::string> make_sort_strings( std::size_t count )
+{
+    std::vector<std::string> result;
+    std::uint32_t x = 12345;
+
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        x = x * 1103515245u + 12345u;
+
+        std::string text( x % 7 == 0 ? "" : "https://example.com/" );
+
+        for ( std::uint32_t k = x >> 28; k > 0; --k )
+            text += static_cast<char>( "ab\x80\xff"[ ( x >> ( 2 * k ) ) & 3 ] );
+
+        result.push_back( text );
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+CASE( "sort_strings: range of string_views in the order of operator<" )
+{
+    std::vector<std::string> strings = make_sort_strings( 5000 );
+    std::vector<std17::string_view> views( strings.begin(), strings.end() );
+    std::vector<std17::string_view> expected( views );
+
+    std::sort( expected.begin(), expected.end() );
+
+    for ( std::size_t n : { std::size_t( 0 ), std::size_t( 1 ), std::size_t( 10 ), std::size_t( 100 ), views.size() } )
+    {
+        std::vector<std17::string_view> sorted( views.begin(), views.begin() + static_cast<std::ptrdiff_t>( n ) );
+        std::vector<std17::string_view> check( sorted );
+
+        sort_strings( sorted.begin(), sorted.end() );
+        std::sort( check.begin(), check.end() );
+
+        EXPECT( sorted == check );
+    }
+
+    sort_strings( views.begin(), views.end() );
+
+    EXPECT( views == expected );
+}
+
+CASE( "sort_strings: range of strings, such as from split()" )
+{
+    std::vector<std::string> strings = make_sort_strings( 3000 );
+    std::vector<std::string> expected( strings );
+
+    std::sort( expected.begin(), expected.end() );
+    sort_strings( strings.begin(), strings.end() );
+
+    EXPECT( strings == expected );
+
+    std::vector<std17::string_view> words = split( "pear apple fig apple banana", " " );
+    sort_strings( words.begin(), words.end() );
+
+    EXPECT( join( words, " " ) == "apple apple banana fig pear" );
+}
+
+#if string_CONFIG_PROVIDE_THREADS
+
+CASE( "sort_strings_parallel: same as sort_strings(), with threads for a million strings or more" )
+{
+    std::vector<std::string> strings = make_sort_strings( ( 1u << 20 ) + 1000 );
+    std::vector<std17::string_view> views( strings.begin(), strings.end() );
+    std::vector<std17::string_view> expected( views );
+
+    sort_strings( expected.begin(), expected.end() );
+    sort_strings_parallel( views.begin(), views.end(), 4 );
+
+    EXPECT( views == expected );
+}
+
+#endif // string_CONFIG_PROVIDE_THREADS
+
+// distinct(), count_frequencies()
+
+CASE( "distinct: distinct strings of a range in order of first occurrence" )
+{
+    std::vector<std17::string_view> words = split( "b a c a b d", " " );
+    std::vector<std::string> strings = make_vec_of_strings( "x", "y", "x" );
+
+    EXPECT( join( distinct( words ), "," ) == "b,a,c,d" );
+    EXPECT( join( distinct( strings ), "," ) == "x,y" );
+    EXPECT( distinct( std::vector<std::string>() ).empty() );
+}
+
+CASE( "count_frequencies: count of each distinct string of a range, in order of first occurrence" )
+{
+    frequency_table counts = count_frequencies( split( "b a c a b a", " " ) );
+
+    EXPECT( counts.size() == 3u );
+    EXPECT( counts.count( "a" ) == 3u );
+    EXPECT( counts.count( "b" ) == 2u );
+    EXPECT( counts.count( "c" ) == 1u );
+    EXPECT( counts.count( "d" ) == 0u );
+    EXPECT( counts.begin()->first == "b" );
+    EXPECT( ( counts.begin() + 2 )->first == "c" );
+
+    frequency_table more = count_frequencies( split( "d a", " " ) );
+    counts.merge( more );
+
+    EXPECT( counts.size() == 4u );
+    EXPECT( counts.count( "a" ) == 4u );
+    EXPECT( ( counts.begin() + 3 )->first == "d" );
+}
+
+CASE( "count_frequencies_parallel: same counts and order as count_frequencies(), for chunks via executor, also of lazy ranges" )
+{
+    std::vector<std::string> strings;
+
+    for ( int i = 0; i < 100000; ++i )
+        strings.push_back( std::to_string( i * 7919 % 5003 ) );
+
+    frequency_table const expected = count_frequencies( strings );
+
+    for ( std::size_t nchunks : { 1u, 2u, 5u, 8u } )
+    {
+        frequency_table const counts = count_frequencies_parallel( strings, nchunks, sequential_executor() );
+
+        EXPECT( std::equal( counts.begin(), counts.end(), expected.begin() ) );
+        EXPECT( counts.size() == expected.size() );
+    }
+    std::string const text( "a,b,a,c,a,b" );
+    frequency_table const lazy = count_frequencies_parallel( split_view( text, "," ), 2, sequential_executor() );
+
+    EXPECT( lazy.size() == 3u );
+    EXPECT( lazy.count( "a" ) == 3u );
+    EXPECT( lazy.begin()->first == "a" );
+    EXPECT( count_frequencies( lines( "x\ny\nx" ) ).count( "x" ) == 2u );
+
+#if string_CONFIG_PROVIDE_THREADS
+    frequency_table const counts = count_frequencies_parallel( strings );
+
+    EXPECT( std::equal( counts.begin(), counts.end(), expected.begin() ) );
+    EXPECT( counts.size() == expected.size() );
+#endif
+}
+
+// sorted_string_dict
+
+CASE( "sorted_string_dict: distinct strings of a range in sorted order, index to string and string to index" )
+{
+    sorted_string_dict const dict( split( "pear apple fig apple banana figs", " " ), 2 );
+
+    EXPECT( dict.size() == 5u );
+    EXPECT( dict[0] == "apple" );
+    EXPECT( dict[3] == "figs" );
+    EXPECT( dict[4] == "pear" );
+
+    EXPECT( dict.find( "fig" ) == 2u );
+    EXPECT( dict.find( "fi" ) == npos );
+    EXPECT( dict.find( "zebra" ) == npos );
+    EXPECT( dict.contains( "banana" ) );
+
+    EXPECT( dict.lower_bound( ""  ) == 0u );
+    EXPECT( dict.lower_bound( "c" ) == 2u );
+    EXPECT( dict.lower_bound( "q" ) == 5u );
+
+    EXPECT( join( std::vector<std::string>( dict.begin(), dict.end() ), "," ) == "apple,banana,fig,figs,pear" );
+}
+
+CASE( "sorted_string_dict: strings that start with prefix" )
+{
+    sorted_string_dict const dict( split( "car cart carbon cat dog care", " " ), 4 );
+
+    auto range = dict.prefix_range( "car" );
+
+    EXPECT( join( std::vector<std::string>( range.first, range.second ), "," ) == "car,carbon,care,cart" );
+    EXPECT( range.first.index() == 0u );
+
+    range = dict.prefix_range( "ca" );
+    EXPECT( range.second.index() - range.first.index() == 5u );
+
+    range = dict.prefix_range( "cb" );
+    EXPECT( ( range.first == range.second ) );
+
+    range = dict.prefix_range( "" );
+    EXPECT( ( range.second == dict.end() ) );
+}
+
+CASE( "sorted_string_dict: push_back() strings in increasing order, same as vector of strings, in less memory" )
+{
+    std::vector<std::string> strings;
+
+    for ( int i = 0; i < 20000; ++i )
+        strings.push_back( to_string( "https://example.com/item/" ) + std::to_string( i * 7919 % 100003 ) );
+
+    std::sort( strings.begin(), strings.end() );
+
+    sorted_string_dict dict;
+
+    for ( std::string const & text : strings )
+        dict.push_back( text );
+
+    EXPECT( dict.size() == strings.size() );
+    std::size_t vector_bytes = strings.size() * sizeof( std::string );
+
+    for ( std::string const & text : strings )
+        vector_bytes += text.capacity() + 1;
+
+    EXPECT( dict.bytes() * 4 < vector_bytes );
+    EXPECT( std::equal( dict.begin(), dict.end(), strings.begin() ) );
+
+    for ( std::size_t i = 0; i < strings.size(); i += 7 )
+    {
+        EXPECT( dict[i] == strings[i] );
+        EXPECT( dict.find( strings[i] ) == i );
+        EXPECT( dict.lower_bound( strings[i] + "0" ) == i + 1 );
+    }
+
+    EXPECT_THROWS_AS( dict.push_back( strings.back() ), std::invalid_argument );
+}
+
+// string_map
+
+CASE( "string_map: map of string to value, with lookup by string_view, string or C-string" )
+{
+    string_map<int> map;
+
+    map["one"] = 1;
+    map[std::string( "two" )] = 2;
+    EXPECT( map.try_emplace( "three", 3 ).second );
+    EXPECT_NOT( map.try_emplace( "three", 30 ).second );
+    EXPECT( map.insert( std::make_pair( std17::string_view( "four" ), 4 ) ).second );
+
+    EXPECT( map.size() == 4u );
+    EXPECT( map.at( "three" ) == 3 );
+    EXPECT( map["two"] == 2 );
+    EXPECT( map.find( std17::string_view( "four" ) )->second == 4 );
+    EXPECT( ( map.find( "five" ) == map.end() ) );
+    EXPECT( map.count( "one" ) == 1u );
+    EXPECT_NOT( map.contains( "on" ) );
+    EXPECT_THROWS_AS( (void) map.at( "five" ), std::out_of_range );
+
+    EXPECT( map.begin()->first == "one" );
+    EXPECT( ( std::is_same< string_map<int>::value_type, std::pair<std17::string_view const, int> >::value ) );
+}
+
+CASE( "string_map: values changed via find(), try_emplace() and iteration" )
+{
+    string_map<int> map;
+
+    map["a"] = 1;
+    map["b"] = 2;
+
+    map.find( "a" )->second += 10;
+    map.try_emplace( "b" ).first->second *= 3;
+
+    EXPECT( map.at( "a" ) == 11 );
+    EXPECT( map.at( "b" ) == 6 );
+
+    for ( auto & entry : map )
+        entry.second = 0;
+
+    EXPECT( map.at( "a" ) == 0 );
+    EXPECT( map.at( "b" ) == 0 );
+}
+
+CASE( "string_map: keys are copied into the map, entries in order of insertion, erase() moves the last entry" )
+{
+    string_map<int> map;
+    {
+        std::string key( "temporary" );
+        map[key] = 1;
+        key = "changed";
+    }
+    map["b"] = 2;
+    map["c"] = 3;
+
+    EXPECT( map.at( "temporary" ) == 1 );
+
+    EXPECT( map.erase( "temporary" ) == 1u );
+    EXPECT( map.erase( "temporary" ) == 0u );
+    EXPECT( map.size() == 2u );
+    EXPECT( map.begin()->first == "c" );
+    EXPECT( map.at( "c" ) == 3 );
+    EXPECT( map.at( "b" ) == 2 );
+}
+
+CASE( "string_map: same as std::map, for many inserts, lookups and erasures" )
+{
+    string_map<std::size_t> map;
+    std::map<std::string, std::size_t> expected;
+
+    for ( std::size_t i = 0; i < 30000; ++i )
+    {
+        std::string const key = std::to_string( i * 7919 % 10007 );
+
+        if ( i % 3 == 2 )
+        {
+            EXPECT( map.erase( key ) == expected.erase( key ) );
+        }
+        else
+        {
+            map[key] += i;
+            expected[key] += i;
+        }
+    }
+
+    EXPECT( map.size() == expected.size() );
+
+    for ( auto const & entry : expected )
+        EXPECT( map.at( entry.first ) == entry.second );
+
+    std::size_t found = 0;
+    for ( auto const & entry : map )
+        found += expected.count( to_string( entry.first ) );
+
+    EXPECT( found == expected.size() );
+}
+
 // compare()
 
 CASE( "compare: negative, zero or positive for lsh is less than, equal to or greater than rhs" )
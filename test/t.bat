@@ -17,6 +17,7 @@ echo VC%version%: %args%
 set unit_config=^
     -Dstring_STRING_HEADER=\"nonstd/string.hpp\" ^
     -Dstring_CONFIG_PROVIDE_REGEX=0 ^
+    -Dstring_CONFIG_PROVIDE_THREADS=1 ^
     -Dstring_CONFIG_PROVIDE_CHAR_T=1 ^
     -Dstring_CONFIG_PROVIDE_WCHAR_T=1 ^
     -Dstring_CONFIG_PROVIDE_CHAR8_T=0 ^
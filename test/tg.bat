@@ -21,6 +21,7 @@ echo %gpp% %version%: %std% %args%
 set unit_config=^
     -Dstring_STRING_HEADER=\"nonstd/string.hpp\" ^
     -Dstring_CONFIG_PROVIDE_REGEX=0 ^
+    -Dstring_CONFIG_PROVIDE_THREADS=1 ^
     -Dstring_CONFIG_PROVIDE_CHAR_T=1 ^
     -Dstring_CONFIG_PROVIDE_WCHAR_T=1 ^
     -Dstring_CONFIG_PROVIDE_CHAR8_T=0 ^
@@ -31,7 +32,7 @@ rem -flto / -fwhole-program
 set  optflags=-O2
 set warnflags=-Wall -Wextra -Wpedantic -Wconversion -Wsign-conversion -Wshadow -Wno-padded -Wno-missing-noreturn -Wno-sign-conversion -Wno-conversion
 
-%gpp% -std=%std% %optflags% %warnflags% %unit_config% -o %unit_file%-main.t.exe -isystem lest -I../include -Ics_string -I. %unit_file%-main.t.cpp %unit_file%.t.cpp && %unit_file%-main.t.exe
+%gpp% -std=%std% %optflags% %warnflags% %unit_config% -pthread -o %unit_file%-main.t.exe -isystem lest -I../include -Ics_string -I. %unit_file%-main.t.cpp %unit_file%.t.cpp && %unit_file%-main.t.exe
 
 endlocal & goto :EOF
 